@@ -3,14 +3,21 @@
 #include <chrono>
 #include <cstdlib>
 #include <ctime>
+#include <vector>
+#include "../common/scaling.h" // Перебор потоков и размеров
+#include "../common/stream_stats.h" // Потоковое чтение файла (mmap / куски)
+#include "../common/counter_rng.h" // Параллельный счётчиковый генератор
+#include "../common/roofline.h" // Байты, ГБ/с, % пика STREAM, флоп/байт
+#include "../common/perf_counters.h" // IPC и промахи кэша/TLB/переходов через perf_event_open
+#include <string>
 
 using namespace std;
 
-//1)Заполнение массива случайными числами
-void fill_random(int* arr, int N, int maxValue = 100) {
-    for (int i = 0; i < N; i++) {
-        arr[i] = rand() % maxValue;  
-    }
+//1)Заполнение массива случайными числами 0..maxValue-1
+// Счётчиковый генератор: элемент i зависит только от (seed, i), поэтому заполнение
+// идёт параллельно и даёт одинаковый массив при любом числе потоков
+void fill_random(int* arr, int N, int maxValue = 100, unsigned long long seed = 12345) {
+    counterFillInt(arr, N, 0, maxValue - 1, seed);
 }
 //2)Функция: среднее значение(последовательно)
 double average_sequential(const int* arr, int N, double& time_ms) {
@@ -35,27 +42,77 @@ double average_parallel_omp(const int* arr, int N, double& time_ms) {
     time_ms = chrono::duration<double, milli>(end - start).count();
     return static_cast<double>(sum) / N;
 }
-int main() {
+// Режим масштабирования: потоки 1..ядра, N = 10^4..10^8, слабая — 10^7 на поток
+static void run_scaling() {
+    vector<int> data;
+    ScalingKernel k;
+    k.name = "average_parallel_omp";
+    k.prepare = [&](long long n) {
+        data.resize((size_t)n);
+        fill_random(data.data(), (int)n, 99);
+    };
+    double t = 0.0;
+    k.run = [&]() { average_parallel_omp(data.data(), (int)data.size(), t); };
+    k.traffic = trafficFor<int>(1, 1, 0, 1); // На элемент: 4 байта, 1 сложение
+    BenchReport report("practice1_scaling");
+    auto points = scalingSweep(k, scalingDecades(10'000, 100'000'000), 10'000'000, report);
+    scalingWriteCsv("practice1_scaling.csv", k.name, points);
+    report.save("practice1_scaling_raw");
+}
+// Среднее по бинарному файлу без загрузки в память: 3_task <файл> [int32|float64]
+template <class T>
+static int run_file(const char* path) {
+    StreamStats<T> st;
+    if (!streamStatsFile(path, st)) {
+        cout << "Ошибка: не удалось открыть файл " << path << "\n";
+        return 1;}
+    cout << "Файл: " << path << ", элементов: " << st.count << "\n";
+    cout << "Среднее = " << st.mean() << ", time = " << st.seconds * 1000.0 << " ms, "
+        << st.gbPerSec() << " GB/s\n";
+    return 0;
+}
+int main(int argc, char** argv) {
     setlocale(LC_ALL, "Russian");
-    srand(static_cast<unsigned>(time(nullptr)));
+    if (argc > 1) {
+        if (argc > 2 && string(argv[2]) == "float64") return run_file<double>(argv[1]);
+        return run_file<int>(argv[1]);}
     int N;
-    cout << "Введите N (размер массива): ";
+    cout << "Введите N (размер массива, 0 — режим масштабирования): ";
     cin >> N;
+    if (N == 0) {
+        run_scaling();
+        return 0;}
     if (N <= 0) {
         cout << "Ошибка: N должен быть больше 0.\n";
         return 1;}
     // 1) Динамический массив через указатель
     int* arr = new int[N];
-    fill_random(arr, N, 99);
+    fill_random(arr, N, 99, (unsigned long long)time(nullptr));
     // 2) Среднее последовательно (через функцию)
     double seq_time = 0.0;
-    double avg_seq = average_sequential(arr, N, seq_time);
+    double avg_seq = 0.0;
+    PerfCounts seq_perf, par_perf; // Счётчики perf каждого прохода (пусто, если недоступны)
+    {
+        PerfScope scope(seq_perf);
+        avg_seq = average_sequential(arr, N, seq_time);
+    }
     // 3) Среднее параллельно OpenMP (через функцию)
     double par_time = 0.0;
-    double avg_par = average_parallel_omp(arr, N, par_time);
+    double avg_par = 0.0;
+    {
+        PerfScope scope(par_perf);
+        avg_par = average_parallel_omp(arr, N, par_time);
+    }
+    // Оба прохода читают массив один раз: 4 байта и одно сложение на элемент
+    const Traffic traffic = trafficFor<int>(N, 1, 0, 1);
+    const double peak = hostPeakBandwidth(); // Пик памяти хоста по STREAM
     cout << "\nРезультаты:\n";
-    cout << "Последовательно: среднее = " << avg_seq << ", time = " << seq_time << " ms\n";
-    cout << "Параллельно:     среднее = " << avg_par << ", time = " << par_time << " ms\n";
+    cout << "Последовательно: среднее = " << avg_seq << ", time = " << seq_time << " ms, "
+        << rooflineBrief(seq_time * 1e6, traffic, peak) << "\n";
+    if (seq_perf.any()) cout << "                 " << perfBrief(seq_perf) << "\n";
+    cout << "Параллельно:     среднее = " << avg_par << ", time = " << par_time << " ms, "
+        << rooflineBrief(par_time * 1e6, traffic, peak) << "\n";
+    if (par_perf.any()) cout << "                 " << perfBrief(par_perf) << "\n";
     // 4) Освобождение памяти
     delete[] arr;
     return 0;
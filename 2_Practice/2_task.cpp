@@ -1,66 +1,40 @@
 #include <iostream>
 #include <vector>
 #include <random>
-#include <chrono>
 #include <algorithm>
+#include <chrono>
+#include <fstream>
+#if defined(_MSC_VER)
+#include <intrin.h> // __rdtsc
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h> // __rdtsc
+#endif
 // Подключение OpenMP
 #ifdef _OPENMP
 #include <omp.h>
 #endif
+#include "../common/tournament_tree.h" // Турнирное дерево для сортировки выбором
+#include "../common/bench.h" // Общий замер времени: прогрев, повторы, CSV/JSON
+#include "../common/scaling.h" // Перебор потоков и размеров
+#include "../common/counter_rng.h" // Параллельный счётчиковый генератор
+#include "../common/kernels.h" // Общие шаблонные ядра сортировок
+#include "../common/bitonic_simd.h" // Битонная сеть в SIMD-регистрах для коротких участков
 
 using namespace std;
 // Заполняет вектор случайными числами в диапазоне [lo, hi]
+// Элемент i зависит только от (seed, i): заполнение параллельное, результат не зависит от числа потоков
 static void fillRandom(vector<int>& a, int lo = 1, int hi = 1000000) {
     static random_device rd; // Источник энтропии
-    static mt19937 gen(rd()); // Генератор
-    uniform_int_distribution<int> dist(lo, hi);
-    for (auto& x : a) x = dist(gen); // Присваиваем каждому элементу случайное значение
-}
-// Измерение времени выполнения
-template <class Func>
-static long long timeMs(Func f) {
-    auto t0 = chrono::high_resolution_clock::now();
-    f();
-    auto t1 = chrono::high_resolution_clock::now();
-    return chrono::duration_cast<chrono::milliseconds>(t1 - t0).count();
-}
-// Последовательная сортировка пузырьком
-static void bubbleSortSeq(vector<int>& a) {
-    int n = (int)a.size(); // Размер массива
-    for (int pass = 0; pass < n - 1; pass++) {
-        bool swapped = false; // Флаг наличия обменов за проход
-        for (int j = 0; j < n - 1 - pass; j++) {
-            if (a[j] > a[j + 1]) { // Сравнение соседних элементов
-                swap(a[j], a[j + 1]);
-                swapped = true;
-            }
-        }
-        if (!swapped) break; // Если обменов не было — массив уже отсортирован
-    }
+    static const unsigned long long seed = ((unsigned long long)rd() << 32) | rd(); // seed на запуск
+    counterFillInt(a.data(), (long long)a.size(), lo, hi, seed);
 }
+// Последовательные сортировки — обёртки над шаблонными ядрами из common/kernels.h
+// Последовательная сортировка пузырьком (с ранним выходом)
+static void bubbleSortSeq(vector<int>& a) { kernels::bubbleSortSeq(a.data(), a.size()); }
 // Последовательная сортировка выбором
-static void selectionSortSeq(vector<int>& a) {
-    int n = (int)a.size();
-    for (int i = 0; i < n - 1; i++) {
-        int minIdx = i; // Индекс текущего минимального элемента
-        for (int j = i + 1; j < n; j++)
-            if (a[j] < a[minIdx]) minIdx = j; // Поиск минимального элемента в хвосте массива
-        if (minIdx != i) swap(a[i], a[minIdx]); // Перестановка минимального элемента на позицию i
-    }
-}
+static void selectionSortSeq(vector<int>& a) { kernels::selectionSortSeq(a.data(), a.size()); }
 // Последовательная сортировка вставками
-static void insertionSortSeq(vector<int>& a) {
-    int n = (int)a.size();
-    for (int i = 1; i < n; i++) {
-        int key = a[i]; // Элемент, который нужно вставить
-        int j = i - 1;
-        while (j >= 0 && a[j] > key) {
-            a[j + 1] = a[j]; // Сдвиг элементов вправо
-            j--;
-        }
-        a[j + 1] = key; // Вставка элемента на найденную позицию
-    }
-}
+static void insertionSortSeq(vector<int>& a) { kernels::insertionSortSeq(a.data(), 0, a.size()); }
 // Параллельная пузырьковая сортировка
 static void bubbleSortOmpOddEven(vector<int>& a) {
     int n = (int)a.size(); // Каждая фаза сравнивает независимые пары элементов
@@ -76,6 +50,61 @@ static void bubbleSortOmpOddEven(vector<int>& a) {
         }
     }
 }
+// Блочная чётно-нечётная сортировка: тот же обмен соседей, но соседи — отсортированные блоки.
+// Поток сортирует свой блок, затем в фазах сливает пару соседних блоков (merge-split):
+// младшая половина слияния остаётся в левом блоке, старшая — в правом.
+// Все фазы в одной параллельной области; выход, когда две фазы подряд (чётная и нечётная)
+// ничего не переставили, — обычно около T фаз вместо n.
+static void bubbleSortOmpBlockOddEven(vector<int>& a) {
+    size_t n = a.size();
+    if (n <= 1) return;
+#ifdef _OPENMP
+    vector<int> tmp(n);
+    int moved[4] = { 0, 0, 0, 0 }; // Были ли обмены в фазе, по кругу (phase % 4)
+#pragma omp parallel
+    {
+        int t = omp_get_thread_num();
+        int P = (int)min<size_t>(omp_get_num_threads(), n); // Блоков не больше n, чтобы не было пустых
+        size_t L = 0, R = 0;
+        if (t < P) {
+            kernels::staticChunk(n, t, P, L, R);
+            sort(a.begin() + L, a.begin() + R);
+        }
+#pragma omp barrier
+        for (int phase = 0;; phase++) {
+            // Слот фазы phase + 1 последний раз читали до барьера фазы phase - 1 — его можно обнулить
+            if (t == 0) {
+#pragma omp atomic write
+                moved[(phase + 1) % 4] = 0;
+            }
+            // Пара (t, t + 1) в фазе своей чётности
+            if (t % 2 == phase % 2 && t + 1 < P) {
+                size_t M, RR;
+                kernels::staticChunk(n, t + 1, P, M, RR);
+                // Блоки уже по порядку — слияние не нужно
+                if (a[M] < a[M - 1]) {
+                    kernels::mergeRanges(a.data(), tmp.data(), L, M, RR);
+                    copy(tmp.begin() + L, tmp.begin() + RR, a.begin() + L);
+#pragma omp atomic write
+                    moved[phase % 4] = 1;
+                }
+            }
+#pragma omp barrier
+            // До следующего барьера эти два слота не меняются — все потоки решают одинаково
+            int m0, m1 = 1;
+#pragma omp atomic read
+            m0 = moved[phase % 4];
+            if (phase > 0) {
+#pragma omp atomic read
+                m1 = moved[(phase + 3) % 4];
+            }
+            if (!m0 && !m1) break;
+        }
+    }
+#else
+    sort(a.begin(), a.end());
+#endif
+}
 // Параллельная сортировка выбором
 // параллельно ищем минимум на хвосте, затем редукция по потокам вручную
 static void selectionSortOmp(vector<int>& a) {
@@ -130,12 +159,9 @@ static void selectionSortOmp(vector<int>& a) {
 
 // сортируем блоки вставками параллельно + потом параллельные merge-итерации
 static void mergeRanges(vector<int>& a, vector<int>& tmp, int L, int M, int R) {
-    int i = L, j = M, k = L;
-    while (i < M && j < R) tmp[k++] = (a[i] <= a[j]) ? a[i++] : a[j++];
-    while (i < M) tmp[k++] = a[i++];
-    while (j < R) tmp[k++] = a[j++]; 
+    kernels::mergeRanges(a.data(), tmp.data(), L, M, R);
     // Копирование обратно
-    for (int t = L; t < R; t++) a[t] = tmp[t];
+    copy(tmp.begin() + L, tmp.begin() + R, a.begin() + L);
 }
 
 static void insertionSortOmpBlockMerge(vector<int>& a) {
@@ -155,15 +181,7 @@ static void insertionSortOmpBlockMerge(vector<int>& a) {
     for (int b = 0; b < blocksCount; b++) {
         int L = b * block;
         int R = min(n, L + block);
-        for (int i = L + 1; i < R; i++) {
-            int key = a[i];
-            int j = i - 1;
-            while (j >= L && a[j] > key) {
-                a[j + 1] = a[j];
-                j--;
-            }
-            a[j + 1] = key;
-        }
+        kernels::insertionSortSeq(a.data(), L, R);
     }
     // Параллельное слияние блоков
     vector<int> tmp(n);
@@ -181,21 +199,434 @@ static void insertionSortOmpBlockMerge(vector<int>& a) {
     }
 }
 
-static void runBenchForSize(int n) {
+// Merge-path (co-rank): сколько элементов из A входит в первые diag элементов слияния A и B
+// При равных значениях первым идёт элемент из A — слияние остаётся устойчивым
+static int mergePathSearch(const int* A, int aCount, const int* B, int bCount, int diag) {
+    int lo = max(0, diag - bCount);
+    int hi = min(diag, aCount);
+    while (lo < hi) {
+        int mid = (lo + hi) >> 1;
+        if (A[mid] <= B[diag - mid - 1]) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// Параллельная сортировка слиянием с разбиением merge-path
+// На каждом проходе выходной массив делится на T равных частей независимо от числа пар,
+// поэтому все потоки заняты и на последнем слиянии. Буферы чередуются без копирования назад.
+static void mergeSortMergePathOmp(vector<int>& a) {
+    int n = (int)a.size();
+    if (n <= 1) return;
+    const int leaf = (int)kernels::kBitonicMax; // Короткие участки сортируем битонной сетью
+    vector<int> buf(n);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        int tid = 0, T = 1;
+#ifdef _OPENMP
+        tid = omp_get_thread_num();
+        T = omp_get_num_threads();
+#endif
+        int* src = a.data();
+        int* dst = buf.data();
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (int L = 0; L < n; L += leaf)
+            kernels::sortLeaf(src, L, min(n, L + leaf));
+        // Неявный барьер после omp for: все листья отсортированы
+
+        for (long long width = leaf; width < n; width *= 2) {
+            long long step = 2 * width;
+            // Участок результата, за который отвечает поток
+            int outL = (int)((long long)n * tid / T);
+            int outR = (int)((long long)n * (tid + 1) / T);
+            int pos = outL;
+            while (pos < outR) {
+                // Пара соседних отсортированных серий, в которую попадает pos
+                int left = (int)((pos / step) * step);
+                int mid = (int)min<long long>(n, left + width);
+                int right = (int)min<long long>(n, left + step);
+                const int* A = src + left;
+                const int* B = src + mid;
+                int aCount = mid - left;
+                int bCount = right - mid;
+                int d0 = pos - left;
+                int d1 = min(outR, right) - left;
+                // Границы своего куска в A и B ищем бинарным поиском по диагонали
+                int i = mergePathSearch(A, aCount, B, bCount, d0);
+                int j = d0 - i;
+                int iEnd = mergePathSearch(A, aCount, B, bCount, d1);
+                int jEnd = d1 - iEnd;
+                int* out = dst + left + d0;
+                while (i < iEnd && j < jEnd) *out++ = (A[i] <= B[j]) ? A[i++] : B[j++];
+                while (i < iEnd) *out++ = A[i++];
+                while (j < jEnd) *out++ = B[j++];
+                pos = left + d1;
+            }
+            swap(src, dst); // Следующий проход читает результат текущего
+#ifdef _OPENMP
+#pragma omp barrier
+#endif
+        }
+#ifdef _OPENMP
+#pragma omp single
+#endif
+        {
+            // Результат оказался во втором буфере — меняем векторы местами
+            if (src != a.data()) a.swap(buf);
+        }
+    }
+}
+
+// Параллельная поразрядная сортировка LSD (radix sort), O(n * 32 / radixBits)
+// radixBits — ширина разряда в битах (1..16); у знаковых чисел инвертируем старший бит,
+// тогда беззнаковый порядок ключей совпадает с обычным порядком int
+static void radixSortLsdOmp(vector<int>& a, int radixBits) {
+    int n = (int)a.size();
+    if (n <= 1) return;
+    radixBits = max(1, min(16, radixBits));
+    const int buckets = 1 << radixBits; // Количество корзин в одном разряде
+    const unsigned mask = (unsigned)buckets - 1;
+    const int passes = (32 + radixBits - 1) / radixBits;
+    int T = 1;
+#ifdef _OPENMP
+    T = omp_get_max_threads(); // Потоков не больше этого — по нему размер гистограммы
+#endif
+    vector<int> buf(n); // Второй буфер: проходы чередуются a -> buf -> a
+    vector<int> hist((size_t)T * buckets); // Гистограмма разрядов: своя строка у каждого потока
+    int* src = a.data();
+    int* dst = buf.data();
+
+    for (int pass = 0; pass < passes; pass++) {
+        int shift = pass * radixBits;
+        bool skip = false; // Все элементы попали в одну корзину — проход ничего не меняет
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(T)
+#endif
+        {
+            int tid = 0, nt = 1;
+#ifdef _OPENMP
+            tid = omp_get_thread_num();
+            nt = omp_get_num_threads(); // Команда может оказаться меньше T (OMP_THREAD_LIMIT, OMP_DYNAMIC)
+#endif
+            // Каждый поток работает со своим непрерывным куском массива
+            int L = (int)((long long)n * tid / nt);
+            int R = (int)((long long)n * (tid + 1) / nt);
+            int* h = &hist[(size_t)tid * buckets];
+            fill(h, h + buckets, 0);
+            for (int i = L; i < R; i++)
+                h[(((unsigned)src[i] ^ 0x80000000u) >> shift) & mask]++;
+#ifdef _OPENMP
+#pragma omp barrier
+#pragma omp single
+#endif
+            {
+                // Префиксная сумма в порядке (разряд, поток) — так сортировка остаётся устойчивой
+                int sum = 0;
+                for (int d = 0; d < buckets; d++) {
+                    int before = sum;
+                    for (int t = 0; t < nt; t++) {
+                        int c = hist[(size_t)t * buckets + d];
+                        hist[(size_t)t * buckets + d] = sum;
+                        sum += c;
+                    }
+                    if (sum - before == n) skip = true;
+                }
+            }
+            // Раскладка: поток пишет в свои заранее вычисленные позиции, гонок нет
+            if (!skip) {
+                for (int i = L; i < R; i++)
+                    dst[h[(((unsigned)src[i] ^ 0x80000000u) >> shift) & mask]++] = src[i];
+            }
+        }
+        if (!skip) swap(src, dst);
+    }
+    // Результат оказался во втором буфере — меняем векторы местами без копирования
+    if (src != a.data()) a.swap(buf);
+}
+
+// Обёртки с фиксированной шириной разряда для таблицы тестов
+static void radixSortOmp8(vector<int>& a) { radixSortLsdOmp(a, 8); }
+static void radixSortOmp11(vector<int>& a) { radixSortLsdOmp(a, 11); }
+
+// Трафик radixSortLsdOmp на данных a: проход с раскладкой читает массив дважды (гистограмма и
+// раскладка) и пишет один раз; проход, где все ключи в одной корзине, — только гистограмма
+static Traffic radixSortTraffic(const vector<int>& a, int radixBits) {
+    unsigned orAll = 0, andAll = ~0u;
+    for (int x : a) {
+        unsigned key = (unsigned)x ^ 0x80000000u;
+        orAll |= key;
+        andAll &= key;
+    }
+    const unsigned diff = orAll ^ andAll; // Биты, в которых ключи различаются
+    const unsigned mask = (1u << radixBits) - 1;
+    int accesses = 0;
+    for (int shift = 0; shift < 32; shift += radixBits)
+        accesses += ((diff >> shift) & mask) ? 3 : 1;
+    return trafficFor<int>((long long)a.size(), accesses, 0, 0);
+}
+
+// Трафик mergeSortMergePathOmp: проход по листьям и каждый проход слияния читают и пишут массив один раз
+static Traffic mergeSortTraffic(long long n) {
+    int passes = 1;
+    for (long long width = (long long)kernels::kBitonicMax; width < n; width *= 2) passes++;
+    return trafficFor<int>(n, passes, passes, 0);
+}
+
+// Быстрая сортировка на задачах OpenMP (work-stealing делает планировщик задач):
+// верхние уровни разбиваются параллельно, дальше меньшая часть уходит в новую задачу,
+// пока участок больше kQsTaskGrain. При слишком глубокой рекурсии — пирамидальная сортировка
+// (как в introsort), участки короче kQsInsertion сортируются листовым ядром kernels::sortLeaf
+// (битонной сетью в SIMD-регистрах).
+static const int kQsInsertion = 64;             // участки короче — битонной сетью
+static const int kQsTaskGrain = 1 << 14;        // участки короче — без новых задач
+static const int kQsParallelPartition = 1 << 20; // участки длиннее — параллельное разбиение
+
+// Медиана трёх значений
+static int median3(int x, int y, int z) {
+    return max(min(x, y), min(max(x, y), z));
+}
+
+// Опорный элемент: медиана трёх для коротких участков, "девятка" Тьюки для длинных
+static int choosePivot(const int* a, int L, int R) {
+    int n = R - L, m = L + n / 2;
+    if (n < 1024) return median3(a[L], a[m], a[R - 1]);
+    int s = n / 8;
+    return median3(median3(a[L], a[L + s], a[L + 2 * s]),
+                   median3(a[m - s], a[m], a[m + s]),
+                   median3(a[R - 1 - 2 * s], a[R - 1 - s], a[R - 1]));
+}
+
+// Трёхчастное разбиение (голландский флаг): [L, lt) < p, [lt, gt) == p, [gt, R) > p.
+// Равные опорному сразу выпадают из рекурсии — массивы с повторами не деградируют до O(n^2)
+static void partition3(int* a, int L, int R, int p, int& lt, int& gt) {
+    int i = L;
+    lt = L;
+    gt = R;
+    while (i < gt) {
+        if (a[i] < p) swap(a[lt++], a[i++]);
+        else if (a[i] > p) swap(a[i], a[--gt]);
+        else i++;
+    }
+}
+
+// Разбиение Хоара: [L, lt) <= p, [lt, R) >= p (здесь gt == lt). Меньше обменов, чем у флага,
+// на отсортированном входе обменов нет вовсе; равные опорному делятся поровну между частями.
+// Если одна из частей вышла пустой — трёхчастное разбиение, которое гарантированно продвигается
+static void partitionStep(int* a, int L, int R, int p, int& lt, int& gt) {
+    int i = L - 1, j = R;
+    for (;;) {
+        do i++; while (a[i] < p); // p — значение из [L, R), поэтому сканы не выходят за границы
+        do j--; while (a[j] > p);
+        if (i >= j) break;
+        swap(a[i], a[j]);
+    }
+    lt = gt = j + 1;
+    if (lt <= L || lt >= R) partition3(a, L, R, p, lt, gt);
+}
+
+// То же разбиение параллельно: куски считают свои "<", "==", ">" и раскладывают их
+// во временный буфер по префиксным суммам, затем буфер копируется обратно.
+// Работает внутри задачи: taskloop отдаёт куски свободным потокам
+static void partition3Parallel(int* a, int* tmp, int L, int R, int p, int& lt, int& gt) {
+    int chunks = 1;
+#ifdef _OPENMP
+    chunks = 4 * omp_get_num_threads();
+#endif
+    int n = R - L;
+    vector<int> counts((size_t)chunks * 3, 0);
+    int* cnt = counts.data(); // Указатель: в taskloop локальные переменные по умолчанию firstprivate
+#ifdef _OPENMP
+#pragma omp taskloop num_tasks(chunks)
+#endif
+    for (int c = 0; c < chunks; c++) {
+        int cl = L + (int)((long long)n * c / chunks), cr = L + (int)((long long)n * (c + 1) / chunks);
+        int less = 0, equal = 0;
+        for (int i = cl; i < cr; i++) {
+            less += a[i] < p;
+            equal += a[i] == p;
+        }
+        cnt[3 * c] = less;
+        cnt[3 * c + 1] = equal;
+        cnt[3 * c + 2] = (cr - cl) - less - equal;
+    }
+    // Смещения: сначала все "<" по порядку кусков, затем "==", затем ">"
+    int pos = L;
+    for (int k = 0; k < 3; k++) {
+        if (k == 1) lt = pos;
+        if (k == 2) gt = pos;
+        for (int c = 0; c < chunks; c++) {
+            int v = cnt[3 * c + k];
+            cnt[3 * c + k] = pos;
+            pos += v;
+        }
+    }
+#ifdef _OPENMP
+#pragma omp taskloop num_tasks(chunks)
+#endif
+    for (int c = 0; c < chunks; c++) {
+        int cl = L + (int)((long long)n * c / chunks), cr = L + (int)((long long)n * (c + 1) / chunks);
+        int o0 = cnt[3 * c], o1 = cnt[3 * c + 1], o2 = cnt[3 * c + 2];
+        for (int i = cl; i < cr; i++) {
+            int v = a[i];
+            if (v < p) tmp[o0++] = v;
+            else if (v == p) tmp[o1++] = v;
+            else tmp[o2++] = v;
+        }
+    }
+#ifdef _OPENMP
+#pragma omp taskloop num_tasks(chunks)
+#endif
+    for (int c = 0; c < chunks; c++) {
+        int cl = L + (int)((long long)n * c / chunks), cr = L + (int)((long long)n * (c + 1) / chunks);
+        copy(tmp + cl, tmp + cr, a + cl);
+    }
+}
+
+// Последовательная introsort-часть на участке [L, R)
+static void quickSortSeqRange(int* a, int L, int R, int depth) {
+    while (R - L > kQsInsertion) {
+        if (depth-- == 0) { // Плохие опорные: гарантированные O(n log n)
+            make_heap(a + L, a + R);
+            sort_heap(a + L, a + R);
+            return;
+        }
+        int lt, gt;
+        partitionStep(a, L, R, choosePivot(a, L, R), lt, gt);
+        // Рекурсия в меньшую часть, цикл по большей — глубина стека O(log n)
+        if (lt - L < R - gt) { quickSortSeqRange(a, L, lt, depth); L = gt; }
+        else { quickSortSeqRange(a, gt, R, depth); R = lt; }
+    }
+    kernels::sortLeaf(a, L, R);
+}
+
+static void quickSortTask(int* a, int* tmp, int L, int R, int depth) {
+    while (R - L > kQsTaskGrain) {
+        if (depth-- == 0) {
+            make_heap(a + L, a + R);
+            sort_heap(a + L, a + R);
+            return;
+        }
+        int p = choosePivot(a, L, R);
+        int lt, gt;
+        if (tmp && R - L >= kQsParallelPartition) partition3Parallel(a, tmp, L, R, p, lt, gt);
+        else partitionStep(a, L, R, p, lt, gt);
+        // Меньшая часть — новая задача (её может забрать свободный поток), большая — в этом же цикле
+        int sL = L, sR = lt;
+        if (lt - L >= R - gt) { sL = gt; sR = R; R = lt; }
+        else L = gt;
+#ifdef _OPENMP
+#pragma omp task firstprivate(sL, sR, depth)
+#endif
+        quickSortTask(a, tmp, sL, sR, depth);
+    }
+    quickSortSeqRange(a, L, R, depth);
+}
+
+static void quickSortTasksOmp(vector<int>& a) {
+    int n = (int)a.size();
+    if (n <= 1) return;
+    int depth = 0; // Предел глубины 2 * log2(n), как в introsort
+    for (int m = n; m > 1; m >>= 1) depth += 2;
+    vector<int> tmp;
+    if (n >= kQsParallelPartition) tmp.resize(n); // Буфер для параллельного разбиения
+    int* t = tmp.empty() ? nullptr : tmp.data();
+#ifdef _OPENMP
+#pragma omp parallel
+#pragma omp single nowait
+#endif
+    quickSortTask(a.data(), t, 0, n, depth);
+    // Барьер в конце parallel дожидается всех порождённых задач
+}
+
+// Неудобные для быстрой сортировки входы
+enum class InputKind { Uniform, Skewed, Sorted, Duplicates };
+
+static const char* inputKindName(InputKind k) {
+    switch (k) {
+    case InputKind::Skewed: return "перекос";
+    case InputKind::Sorted: return "отсортирован";
+    case InputKind::Duplicates: return "много повторов";
+    default: return "равномерный";
+    }
+}
+
+static void fillInput(vector<int>& a, InputKind kind) {
+    long long n = (long long)a.size();
+    int* d = a.data();
+    switch (kind) {
+    case InputKind::Skewed: // u^8: большая часть значений прижата к нулю
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (long long i = 0; i < n; i++) {
+            double u = counterUniform01(777, (uint64_t)i);
+            u *= u; u *= u; u *= u;
+            d[i] = (int)(u * 1000000.0);
+        }
+        break;
+    case InputKind::Sorted:
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (long long i = 0; i < n; i++) d[i] = (int)i;
+        break;
+    case InputKind::Duplicates: // 16 различных значений
+        counterFillInt(d, n, 0, 15, 778);
+        break;
+    default:
+        fillRandom(a);
+    }
+}
+
+// Квадратичные сортировки не запускаем на массивах больше этого размера
+static const int kQuadraticMaxN = 100000;
+
+static void runBenchForSize(int n, BenchReport& report) {
     vector<int> base(n);
     fillRandom(base);// Генерация исходных данных
-    auto testOne = [&](const char* name, void(*sortFn)(vector<int>&)) {
-        vector<int> a = base; // Копия массива для сравнения
-        long long ms = timeMs([&] { sortFn(a); });
-        cout << "  " << name << ": " << ms << " ms\n";
+    BenchConfig cfg = BenchConfig::fromEnv();
+    // traffic — модель трафика, если она у сортировки есть; иначе байты в отчёте остаются пустыми
+    auto testOne = [&](const string& name, void(*sortFn)(vector<int>&), Traffic traffic = Traffic()) {
+        vector<int> a;
+        // Перед каждым повтором восстанавливаем исходный массив (в замер не входит)
+        BenchStats st = benchRun(name, n, cfg, [&] { a = base; }, [&] { sortFn(a); });
+        rooflineAttach(st, traffic);
+        report.add(st);
+        cout << "  " << name << ": " << benchBrief(st);
+        if (st.bytes > 0) cout << "; " << rooflineBrief(st, hostPeakBandwidth());
+        if (!is_sorted(a.begin(), a.end())) cout << " (ОШИБКА: не отсортирован)";
+        cout << "\n";
         };
     cout << "\nN = " << n << "\n";
-    testOne("Послд. Метод пузырьком", bubbleSortSeq);
-    testOne("Послд. Метод выбором", selectionSortSeq);
-    testOne("Послд. Метод вставкой", insertionSortSeq);
-    testOne("Парал. Метод пузырьком", bubbleSortOmpOddEven);
-    testOne("Парал. Метод выбором", selectionSortOmp);
-    testOne("Парал. Метод вставкой", insertionSortOmpBlockMerge);
+    if (n <= kQuadraticMaxN) {
+        testOne("Послд. Метод пузырьком", bubbleSortSeq);
+        testOne("Послд. Метод выбором", selectionSortSeq);
+        testOne("Послд. Метод вставкой", insertionSortSeq);
+        testOne("Парал. Метод пузырьком", bubbleSortOmpOddEven);
+        testOne("Парал. Метод выбором", selectionSortOmp);
+        testOne("Парал. Метод вставкой", insertionSortOmpBlockMerge);
+    }
+    else {
+        cout << "  O(n^2) сортировки пропущены (N > " << kQuadraticMaxN << ")\n";
+    }
+    testOne("Парал. Пузырьком (блочный чёт-нечёт)", bubbleSortOmpBlockOddEven);
+    testOne("Парал. Выбор (турнирное дерево)", tournamentSelectionSort<int>);
+    testOne("Парал. Слияние (merge path)", mergeSortMergePathOmp, mergeSortTraffic(n));
+    testOne("Парал. Поразрядная (8 бит)", radixSortOmp8, radixSortTraffic(base, 8));
+    testOne("Парал. Поразрядная (11 бит)", radixSortOmp11, radixSortTraffic(base, 11));
+    testOne("Парал. Быстрая (задачи)", quickSortTasksOmp);
+    // Быстрая сортировка на входах, где плохой выбор опорного особенно заметен
+    for (InputKind kind : { InputKind::Skewed, InputKind::Sorted, InputKind::Duplicates }) {
+        fillInput(base, kind);
+        testOne(string("Парал. Быстрая (задачи) [") + inputKindName(kind) + "]", quickSortTasksOmp);
+    }
 }
 // Функция запуска  задачи
 void run_task2() {
@@ -207,6 +638,83 @@ void run_task2() {
     cout << "\n[Task 2] OpenMP NOT enabled (macros _OPENMP not defined).\n";
 #endif
 
-    vector<int> sizes = { 1000, 10000, 100000 };
-    for (int n : sizes) runBenchForSize(n); // Запуск тестов для каждого размера
-    cout << "\n";} 
+    BenchReport report("practice2_sort");
+    report.setPeakGBps(hostPeakBandwidth()); // Пик STREAM — для столбца % пика
+    vector<int> sizes = { 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+    for (int n : sizes) runBenchForSize(n, report); // Запуск тестов для каждого размера
+    report.save("practice2_sort"); // practice2_sort.csv / practice2_sort.json
+    cout << "\nРезультаты сохранены в practice2_sort.csv и practice2_sort.json\n";} 
+// Режим масштабирования чётно-нечётной сортировки: потоки 1..ядра, N = 10^3..10^4
+// (n фаз по n/2 сравнений — O(n^2), поэтому большие N не берём)
+void run_task2_scaling() {
+    vector<int> base, a;
+    ScalingKernel k;
+    k.name = "bubbleSortOmpOddEven";
+    k.prepare = [&](long long n) { base.resize((size_t)n); fillRandom(base); };
+    k.reset = [&]() { a = base; }; // Сортировка портит вход
+    k.run = [&]() { bubbleSortOmpOddEven(a); };
+    BenchReport report("practice2_scaling");
+    auto points = scalingSweep(k, scalingDecades(1000, 10000), 2000, report);
+    scalingWriteCsv("practice2_scaling.csv", k.name, points);
+    report.save("practice2_scaling_raw");
+}
+
+// Счётчик тактов: TSC на x86 (такты опорной частоты), иначе наносекунды
+static unsigned long long cycleCounter() {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return (unsigned long long)chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Тактов на элемент при сортировке blocks участков длины len (лучший из reps прогонов)
+template <class T, class SortFn>
+static double cyclesPerElement(const vector<T>& base, size_t len, SortFn sortFn, int reps = 7) {
+    vector<T> a;
+    double best = 1e300;
+    for (int r = 0; r < reps; r++) {
+        a = base;
+        unsigned long long c0 = cycleCounter();
+        for (size_t off = 0; off + len <= a.size(); off += len) sortFn(a.data() + off, len);
+        unsigned long long c1 = cycleCounter();
+        best = min(best, (double)(c1 - c0) / (double)a.size());
+    }
+    // Проверка: каждый участок отсортирован
+    for (size_t off = 0; off + len <= a.size(); off += len)
+        if (!is_sorted(a.begin() + off, a.begin() + off + len)) return -1.0;
+    return best;
+}
+
+// Листовое ядро: битонная сеть против вставок на участках 8..64 элементов (int и float)
+void run_task2_bitonic() {
+    const size_t total = (size_t)1 << 20; // Элементов в одном прогоне (участки подряд)
+    vector<int> baseInt(total);
+    counterFillInt(baseInt.data(), (long long)total, 0, 1000000000, 2024);
+    vector<float> baseFloat(total);
+    for (size_t i = 0; i < total; i++) baseFloat[i] = (float)counterUniform01(2025, i);
+
+    ofstream csv("practice2_bitonic.csv");
+    csv << "type,len,bitonic_cycles_per_elem,insertion_cycles_per_elem,speedup\n";
+    cout << "\n[Битонная сеть] такты на элемент, " << kernels::kBitonicIsa
+         << ", дорожек в регистре: " << kernels::kBitonicLanes << "\n";
+    if (kernels::kBitonicLanes == 1)
+        cout << "  ВНИМАНИЕ: SIMD-сеть не собрана (нужен x86-64 с SSE2; быстрее -msse4.1 / -mavx2),\n"
+             << "  колонка \"сеть\" — те же вставки\n";
+    auto row = [&](const char* type, size_t len, double bit, double ins) {
+        cout << "  " << type << " len=" << len << ": сеть " << bit << ", вставки " << ins
+             << ", ускорение x" << (bit > 0 ? ins / bit : 0.0)
+             << ((bit < 0 || ins < 0) ? " (ОШИБКА: не отсортирован)" : "") << "\n";
+        csv << type << "," << len << "," << bit << "," << ins << "," << (bit > 0 ? ins / bit : 0.0) << "\n";
+    };
+    for (size_t len : { (size_t)8, (size_t)16, (size_t)32, (size_t)64 }) {
+        row("int", len,
+            cyclesPerElement(baseInt, len, [](int* p, size_t m) { kernels::bitonicSortSmall(p, m); }),
+            cyclesPerElement(baseInt, len, [](int* p, size_t m) { kernels::insertionSortSeq(p, 0, m); }));
+        row("float", len,
+            cyclesPerElement(baseFloat, len, [](float* p, size_t m) { kernels::bitonicSortSmall(p, m); }),
+            cyclesPerElement(baseFloat, len, [](float* p, size_t m) { kernels::insertionSortSeq(p, 0, m); }));
+    }
+    cout << "Результаты сохранены в practice2_bitonic.csv\n";
+}
@@ -4,12 +4,16 @@
 void run_task1();
 void run_task2();
 void run_task3();
+void run_task2_scaling();
+void run_task2_bitonic();
 
 int main() {
     setlocale(LC_ALL, "Russian");
     while (true) {
         std::cout << "1 - Задача 1\n";
         std::cout << "2 - Задача 2\n";
+        std::cout << "3 - Масштабирование (чётно-нечётная сортировка)\n";
+        std::cout << "4 - Битонная сеть против вставок (такты на элемент)\n";
         std::cout << "0 - Выход\n";
         std::cout << "Выбор: ";
 
@@ -29,6 +33,8 @@ int main() {
         switch (choice) {
         case 1: run_task1(); break;
         case 2: run_task2(); break;
+        case 3: run_task2_scaling(); break;
+        case 4: run_task2_bitonic(); break;
         default:
             std::cout << "Неверный выбор. Повторите.\n";
             break;
@@ -1,17 +1,16 @@
 #include <iostream> // Ввод и вывод данных (cout, cin)
-#include <cstdlib> // rand(), srand()
 #include <ctime> // Работа со временем
+#include "../common/counter_rng.h" // Параллельный счётчиковый генератор
 
 using namespace std;
 void task1() {
     const int SIZE = 50000;
     // Динамическое выделение памяти
     int* arr = new int[SIZE];
-    srand((unsigned)time(nullptr));
+    // Заполнение массива случайными числами от 1 до 100 (seed — текущее время)
+    counterFillInt(arr, SIZE, 1, 100, (unsigned long long)time(nullptr));
     long long sum = 0;
-    // Заполнение массива случайными числами от 1 до 100
     for (int i = 0; i < SIZE; i++) {
-        arr[i] = rand() % 100 + 1;
         sum += arr[i];
     }
     // Вычисление среднего значения
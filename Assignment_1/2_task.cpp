@@ -1,40 +1,44 @@
 #include <iostream>
 #include <cstdlib>
+#include "../common/counter_rng.h" // Параллельный счётчиковый генератор
 #include <ctime>
-#include <chrono> // Измерение времени выполнения
+#include "../common/bench.h" // Замер времени: прогрев, повторы, CSV/JSON
+#include "../common/roofline.h" // Байты, ГБ/с, % пика STREAM, флоп/байт
 
 using namespace std;
-using namespace chrono;
 
 void task2() {
     const int SIZE = 1'000'000;
     // Динамическое выделение памяти
     int* arr = new int[SIZE];
-    srand((unsigned)time(nullptr));
-    // Заполнение массива случайными числами от 1 до 1 000 000
-    for (int i = 0; i < SIZE; i++) {
-        arr[i] = rand();
-    }
+    // Заполнение массива случайными числами 0..RAND_MAX (параллельно, seed — текущее время)
+    counterFillInt(arr, SIZE, 0, RAND_MAX, (unsigned long long)time(nullptr));
     cout << "[Task 2]\n";
     cout << "Поиск минимума и максимума (последовательно)\n";
-    // Замер времени начала
-    auto start = high_resolution_clock::now();
     int minVal = arr[0];
     int maxVal = arr[0];
-
-    // Последовательный поиск min и max
-    for (int i = 1; i < SIZE; i++) {
-        if (arr[i] < minVal)
-            minVal = arr[i];
-        if (arr[i] > maxVal)
-            maxVal = arr[i];
-    }
-    // Замер времени окончания
-    auto end = high_resolution_clock::now();
-    auto duration = duration_cast<milliseconds>(end - start);
+    // Замер: прогрев + несколько повторов, в консоль — медиана
+    BenchReport report("assignment1_task2");
+    BenchStats st = benchRun("minmax_sequential", SIZE, BenchConfig::fromEnv(), [&]() {
+        minVal = arr[0];
+        maxVal = arr[0];
+        // Последовательный поиск min и max
+        for (int i = 1; i < SIZE; i++) {
+            if (arr[i] < minVal)
+                minVal = arr[i];
+            if (arr[i] > maxVal)
+                maxVal = arr[i];
+        }
+        });
+    rooflineAttach(st, trafficFor<int>(SIZE, 1, 0, 2)); // Одно чтение массива, 2 сравнения на элемент
+    const double peak = hostPeakBandwidth();
+    report.setPeakGBps(peak);
+    report.add(st);
     cout << "Минимум: " << minVal << endl;
     cout << "Максимум: " << maxVal << endl;
-    cout << "Время выполнения: " << duration.count() << " мс\n";
+    cout << "Время выполнения: " << benchBrief(st) << "\n";
+    cout << "Память: " << rooflineBrief(st, peak) << "\n";
+    report.save("assignment1_task2");
     // Освобождение памяти
     delete[] arr;
 }
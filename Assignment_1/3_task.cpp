@@ -1,36 +1,33 @@
 #include <iostream>
 #include <cstdlib>
 #include <ctime>
-#include <chrono>
 #include <limits>  // numeric_limits для инициализации min/max
 
 #ifdef _OPENMP
 #include <omp.h> // Подключение OpenMP
 #endif
+#include "../common/bench.h" // Замер времени: прогрев, повторы, CSV/JSON
+#include "../common/counter_rng.h" // Параллельный счётчиковый генератор
+#include "../common/numa_buffer.h" // First-touch буфер и размещение по NUMA-узлам
+#include "../common/scaling.h" // Перебор потоков и размеров
+#include "../common/kernels.h" // Общие шаблонные ядра редукций
+#include "../common/roofline.h" // Байты, ГБ/с, % пика STREAM, флоп/байт
 
 using namespace std;
-using namespace chrono;
+
+// Совмещённый проход min/max/sum/mean (AVX2 + OpenMP), реализация в stats_fused.cpp
+void statsFusedOMP(const int* arr, int n, int& outMin, int& outMax, long long& outSum, double& outMean);
 
 // Функция заполнения массива случайными числами
 static void fillRandom(int* arr, int n) {
-    // фиксируем seed, чтобы последовательный и параллельный запуск сравнивались честно
-    srand(12345);
-    for (int i = 0; i < n; i++) {
-        arr[i] = rand(); // 0..RAND_MAX
-    }
+    // фиксируем seed, чтобы последовательный и параллельный запуск сравнивались честно;
+    // элемент i зависит только от (seed, i) — заполнение параллельное и не зависит от числа потоков
+    counterFillInt(arr, n, 0, RAND_MAX, 12345); // 0..RAND_MAX
 }
 
-// Последовательный поиск min/max
+// Последовательный поиск min/max (шаблонное ядро: без ветвлений, по дорожкам SIMD)
 static void minmaxSequential(const int* arr, int n, int& outMin, int& outMax) {
-    int mn = arr[0];
-    int mx = arr[0];
-    for (int i = 1; i < n; i++) {
-        if (arr[i] < mn) mn = arr[i];
-        if (arr[i] > mx) mx = arr[i];
-    }
-    // Возвращаем результат через ссылки
-    outMin = mn;
-    outMax = mx;
+    kernels::minmaxSequential(arr, (size_t)n, outMin, outMax);
 }
 
 // Параллельный поиск min/max (OpenMP)
@@ -45,7 +42,7 @@ static void minmaxParallelOMP(const int* arr, int n, int& outMin, int& outMax) {
         int localMin = numeric_limits<int>::max();
         int localMax = numeric_limits<int>::min();
     // Распределяем цикл по потокам
-#pragma omp for nowait
+#pragma omp for schedule(static) nowait
         for (int i = 0; i < n; i++) {
             if (arr[i] < localMin) localMin = arr[i];
             if (arr[i] > localMax) localMax = arr[i];
@@ -66,43 +63,104 @@ static void minmaxParallelOMP(const int* arr, int n, int& outMin, int& outMax) {
     minmaxSequential(arr, n, outMin, outMax);
 #endif
 }
-// Основная функция
-void task3() {
-    const int SIZE = 1'000'000;
-    int* arr = new int[SIZE];
+// Режим масштабирования min/max: потоки 1..ядра, N = 10^4..10^8
+void task3Scaling() {
+    NumaBuffer<int> data;
+    ScalingKernel k;
+    k.name = "minmax_parallel_omp";
+    k.prepare = [&](long long n) {
+        data = NumaBuffer<int>((size_t)n, numaHugePagesFromEnv()); // Параллельный first-touch
+        fillRandom(data.data(), (int)n);
+    };
+    int mn = 0, mx = 0;
+    k.run = [&]() { minmaxParallelOMP(data.data(), (int)data.size(), mn, mx); };
+    k.traffic = trafficFor<int>(1, 1, 0, 2); // На элемент: 4 байта, 2 сравнения
+    BenchReport report("assignment1_task3_scaling");
+    auto points = scalingSweep(k, scalingDecades(10'000, 100'000'000), 10'000'000, report);
+    scalingWriteCsv("assignment1_task3_scaling.csv", k.name, points);
+    report.save("assignment1_task3_scaling_raw");
+}
+
+// Один размер массива: последовательный, OpenMP и SIMD-проход, проверка и ускорение
+static void task3Size(const int SIZE, const BenchConfig& cfg, BenchReport& report, double peak) {
+    // Страницы массива первыми касаются те же потоки (schedule(static)), что потом его читают
+    NumaBuffer<int> buf(SIZE, numaHugePagesFromEnv());
+    int* arr = buf.data();
     fillRandom(arr, SIZE);
-    cout << "[Task 3]\n";
-    cout << "Сравнение последовательного и параллельного (OpenMP) поиска min/max\n";
+    string placement = numaPlacement(arr, (size_t)SIZE * sizeof(int));
+    // Каждый замер читает массив один раз: min/max — 2 сравнения на элемент, fused — ещё сложение
+    const Traffic minmaxTraffic = trafficFor<int>(SIZE, 1, 0, 2);
+    const Traffic fusedTraffic = trafficFor<int>(SIZE, 1, 0, 3);
+    cout << "\nN = " << SIZE << "\n";
 
     // Последовательное измерени
     int seqMin = 0, seqMax = 0;
-    auto startSeq = high_resolution_clock::now();
-    minmaxSequential(arr, SIZE, seqMin, seqMax);
-    auto endSeq = high_resolution_clock::now();
-    auto seqMs = duration_cast<milliseconds>(endSeq - startSeq).count();
+    BenchStats seqSt = benchRun("minmax_sequential", SIZE, cfg, [&]() {
+        minmaxSequential(arr, SIZE, seqMin, seqMax); });
+    seqSt.note = placement;
+    rooflineAttach(seqSt, minmaxTraffic);
+    report.add(seqSt);
+    double seqMs = seqSt.ms();
 
     // Параллельное измерение
     int parMin = 0, parMax = 0;
-    auto startPar = high_resolution_clock::now();
-    minmaxParallelOMP(arr, SIZE, parMin, parMax);
-    auto endPar = high_resolution_clock::now();
-    auto parMs = duration_cast<milliseconds>(endPar - startPar).count();
+    BenchStats parSt = benchRun("minmax_parallel_omp", SIZE, cfg, [&]() {
+        minmaxParallelOMP(arr, SIZE, parMin, parMax); });
+    parSt.note = placement;
+    rooflineAttach(parSt, minmaxTraffic);
+    report.add(parSt);
+    double parMs = parSt.ms();
+
+    // Совмещённый SIMD-проход (min, max, сумма и среднее за одно чтение массива)
+    int fusedMin = 0, fusedMax = 0;
+    long long fusedSum = 0;
+    double fusedMean = 0.0;
+    BenchStats fusedSt = benchRun("stats_fused_simd", SIZE, cfg, [&]() {
+        statsFusedOMP(arr, SIZE, fusedMin, fusedMax, fusedSum, fusedMean); });
+    fusedSt.note = placement;
+    rooflineAttach(fusedSt, fusedTraffic);
+    report.add(fusedSt);
+    double fusedMs = fusedSt.ms();
     cout << "\nРезультаты:\n";
     cout << "Послед -> min: " << seqMin << ", max: " << seqMax
-        << ", time: " << seqMs << " ms\n";
+        << ", time: " << benchBrief(seqSt) << "\n         " << rooflineBrief(seqSt, peak) << "\n";
     cout << "Парал   -> min: " << parMin << ", max: " << parMax
-        << ", time: " << parMs << " ms\n";
+        << ", time: " << benchBrief(parSt) << "\n         " << rooflineBrief(parSt, peak) << "\n";
+    cout << "SIMD    -> min: " << fusedMin << ", max: " << fusedMax
+        << ", avg: " << fusedMean << ", time: " << benchBrief(fusedSt)
+        << "\n         " << rooflineBrief(fusedSt, peak) << "\n";
+    cout << "NUMA-размещение: " << placement
+        << ", huge pages: " << (buf.hugePages() ? "on" : "off") << "\n";
     // Проверка корректности
-    if (seqMin == parMin && seqMax == parMax) {
+    if (seqMin == parMin && seqMax == parMax && seqMin == fusedMin && seqMax == fusedMax) {
         cout << "Проверка: OK (результаты совпадают)\n";}
     else {
         cout << "Проверка: ERROR (результаты НЕ совпадают)\n";}
     // Расчет ускорения
     if (parMs > 0) {
-        double speedup = (double)seqMs / (double)parMs;
+        double speedup = seqMs / parMs;
         cout << "Ускорение (speedup): " << speedup << "x\n";}
     else {
         cout << "Ускорение: нельзя посчитать (слишком маленькое время)\n";}
-    // Освобождение выделенной памяти
-    delete[] arr;
+    if (fusedMs > 0) {
+        cout << "Ускорение SIMD (seq/fused): " << seqMs / fusedMs << "x\n";}
+    // Память освобождает деструктор NumaBuffer
+}
+
+// Основная функция
+void task3() {
+    cout << "[Task 3]\n";
+    cout << "Сравнение последовательного и параллельного (OpenMP) поиска min/max\n";
+
+    // Каждый замер: прогрев + повторы, дальше используется медиана (см. common/bench.h)
+    BenchConfig cfg = BenchConfig::fromEnv();
+    BenchReport report("assignment1_task3");
+    const double peak = hostPeakBandwidth(); // Пик памяти хоста по STREAM (один раз на процесс)
+    report.setPeakGBps(peak);
+
+    // Массив из задания 2 (10^6 int = 4 МБ) помещается в кэш, поэтому ускорение ограничивает
+    // накладной расход потоков; на 5*10^6 (20 МБ, обычно больше L3) видно ускорение, упирающееся в память
+    task3Size(1'000'000, cfg, report, peak);
+    task3Size(5'000'000, cfg, report, peak);
+    report.save("assignment1_task3");
 }
@@ -1,29 +1,30 @@
 #include <iostream>
 #include <cstdlib>
-#include <chrono>
 
 #ifdef _OPENMP
 #include <omp.h>
 #endif
+#include "../common/bench.h" // Замер времени: прогрев, повторы, CSV/JSON
+#include "../common/counter_rng.h" // Параллельный счётчиковый генератор
+#include "../common/numa_buffer.h" // First-touch буфер и размещение по NUMA-узлам
+#include "../common/scaling.h" // Перебор потоков и размеров
+#include "../common/kernels.h" // Общие шаблонные ядра редукций
+#include "../common/roofline.h" // Байты, ГБ/с, % пика STREAM, флоп/байт
 
 using namespace std;
-using namespace chrono;
+
+// Совмещённый проход min/max/sum/mean (AVX2 + OpenMP), реализация в stats_fused.cpp
+void statsFusedOMP(const int* arr, int n, int& outMin, int& outMax, long long& outSum, double& outMean);
 // Заполнение массива случайными числами
 static void fillRandom(int* arr, int n) {
     // фиксированный seed — чтобы сравнение было честным/повторяемым
-    srand(12345);
-    for (int i = 0; i < n; i++) {
-        arr[i] = rand() % 100 + 1; // 1..100
-    }
+    // (счётчиковый генератор: параллельно, результат не зависит от числа потоков)
+    counterFillInt(arr, n, 1, 100, 12345); // 1..100
 }
 
+// Последовательное среднее: шаблонное ядро суммирует в int64 по дорожкам SIMD
 static double averageSequential(const int* arr, int n) {
-    long long sum = 0;
-    // Проходим по массиву и суммируем элементы
-    for (int i = 0; i < n; i++) {
-        sum += arr[i];}
-    // Возвращаем среднее арифметическое
-    return (double)sum / n;}
+    return kernels::averageSequential(arr, (size_t)n);}
 
 static double averageParallelOMP(const int* arr, int n) {
     long long sum = 0;
@@ -31,7 +32,7 @@ static double averageParallelOMP(const int* arr, int n) {
 // parallel for — распараллеливает цикл
 // reduction(+:sum) — каждая нить имеет свою копию sum,
 // которая затем безопасно складывается в общий результат
-#pragma omp parallel for reduction(+:sum)
+#pragma omp parallel for reduction(+:sum) schedule(static)
     for (int i = 0; i < n; i++) {
         sum += arr[i];
     }
@@ -43,29 +44,83 @@ static double averageParallelOMP(const int* arr, int n) {
 #endif
 
     return (double)sum / n;}
+// Режим масштабирования среднего: потоки 1..ядра, N = 10^4..10^8
+void task4Scaling() {
+    NumaBuffer<int> data;
+    ScalingKernel k;
+    k.name = "average_parallel_omp";
+    k.prepare = [&](long long n) {
+        data = NumaBuffer<int>((size_t)n, numaHugePagesFromEnv()); // Параллельный first-touch
+        fillRandom(data.data(), (int)n);
+    };
+    double avg = 0.0;
+    k.run = [&]() { avg = averageParallelOMP(data.data(), (int)data.size()); };
+    k.traffic = trafficFor<int>(1, 1, 0, 1); // На элемент: 4 байта, 1 сложение
+    BenchReport report("assignment1_task4_scaling");
+    auto points = scalingSweep(k, scalingDecades(10'000, 100'000'000), 10'000'000, report);
+    scalingWriteCsv("assignment1_task4_scaling.csv", k.name, points);
+    report.save("assignment1_task4_scaling_raw");
+}
+
 // Основная функция
 void task4() {
     const int SIZE = 5'000'000;
-    int* arr = new int[SIZE];
+    // Страницы массива первыми касаются те же потоки (schedule(static)), что потом его читают
+    NumaBuffer<int> buf(SIZE, numaHugePagesFromEnv());
+    int* arr = buf.data();
     fillRandom(arr, SIZE);
+    string placement = numaPlacement(arr, (size_t)SIZE * sizeof(int));
+    // Каждый замер читает массив один раз: сумма — 1 сложение на элемент, fused — ещё min и max
+    const Traffic sumTraffic = trafficFor<int>(SIZE, 1, 0, 1);
+    const Traffic fusedTraffic = trafficFor<int>(SIZE, 1, 0, 3);
     cout << "[Task 4]\n";
     cout << "Среднее значение: последовательный vs OpenMP reduction\n";
+    // Каждый замер: прогрев + повторы, дальше используется медиана (см. common/bench.h)
+    BenchConfig cfg = BenchConfig::fromEnv();
+    BenchReport report("assignment1_task4");
+    const double peak = hostPeakBandwidth(); // Пик памяти хоста по STREAM (один раз на процесс)
+    report.setPeakGBps(peak);
     // Последовательное
-    auto startSeq = high_resolution_clock::now();
-    double avgSeq = averageSequential(arr, SIZE);
-    auto endSeq = high_resolution_clock::now();
-    auto seqMs = duration_cast<milliseconds>(endSeq - startSeq).count();
+    double avgSeq = 0.0;
+    BenchStats seqSt = benchRun("average_sequential", SIZE, cfg, [&]() {
+        avgSeq = averageSequential(arr, SIZE); });
+    seqSt.note = placement;
+    rooflineAttach(seqSt, sumTraffic);
+    report.add(seqSt);
+    double seqMs = seqSt.ms();
     // Параллельное
-    auto startPar = high_resolution_clock::now();
-    double avgPar = averageParallelOMP(arr, SIZE);
-    auto endPar = high_resolution_clock::now();
-    auto parMs = duration_cast<milliseconds>(endPar - startPar).count();
+    double avgPar = 0.0;
+    BenchStats parSt = benchRun("average_parallel_omp", SIZE, cfg, [&]() {
+        avgPar = averageParallelOMP(arr, SIZE); });
+    parSt.note = placement;
+    rooflineAttach(parSt, sumTraffic);
+    report.add(parSt);
+    double parMs = parSt.ms();
+    // Совмещённый SIMD-проход: среднее вместе с min/max за одно чтение массива
+    int fusedMin = 0, fusedMax = 0;
+    long long fusedSum = 0;
+    double avgFused = 0.0;
+    BenchStats fusedSt = benchRun("stats_fused_simd", SIZE, cfg, [&]() {
+        statsFusedOMP(arr, SIZE, fusedMin, fusedMax, fusedSum, avgFused); });
+    fusedSt.note = placement;
+    rooflineAttach(fusedSt, fusedTraffic);
+    report.add(fusedSt);
+    double fusedMs = fusedSt.ms();
     cout << "\nРезультаты:\n";
-    cout << "Послед -> avg: " << avgSeq << ", time: " << seqMs << " ms\n";
-    cout << "Парал   -> avg: " << avgPar << ", time: " << parMs << " ms\n";
+    cout << "Послед -> avg: " << avgSeq << ", time: " << benchBrief(seqSt)
+        << "\n         " << rooflineBrief(seqSt, peak) << "\n";
+    cout << "Парал   -> avg: " << avgPar << ", time: " << benchBrief(parSt)
+        << "\n         " << rooflineBrief(parSt, peak) << "\n";
+    cout << "SIMD    -> avg: " << avgFused << ", min: " << fusedMin << ", max: " << fusedMax
+        << ", time: " << benchBrief(fusedSt) << "\n         " << rooflineBrief(fusedSt, peak) << "\n";
+    cout << "NUMA-размещение: " << placement
+        << ", huge pages: " << (buf.hugePages() ? "on" : "off") << "\n";
     // Проверка близости результатов(на всякий)
     double diff = avgSeq - avgPar;
     if (diff < 0) diff = -diff;
+    double diffFused = avgSeq - avgFused;
+    if (diffFused < 0) diffFused = -diffFused;
+    if (diffFused > diff) diff = diffFused;
     // Проверка корректности результатов
     if (diff < 1e-9) {
         cout << "Проверка: OK (средние совпадают)\n";}
@@ -73,10 +128,12 @@ void task4() {
         cout << "Проверка: WARNING (разница = " << diff << ")\n";}
     // Расчет ускорения
     if (parMs > 0) {
-        double speedup = (double)seqMs / (double)parMs;
+        double speedup = seqMs / parMs;
         cout << "Ускорение (speedup): " << speedup << "x\n";}
     else {
         cout << "Ускорение: нельзя посчитать (слишком маленькое время)\n";}
-    // Освобождение выделенной памяти
-    delete[] arr;
+    if (fusedMs > 0) {
+        cout << "Ускорение SIMD (seq/fused): " << seqMs / fusedMs << "x\n";}
+    report.save("assignment1_task4");
+    // Память освобождает деструктор NumaBuffer
 }
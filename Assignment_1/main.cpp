@@ -5,6 +5,10 @@ void task1(); // Эти функции реализуют логику кажд
 void task2();
 void task3();
 void task4();
+void task3Scaling(); // Масштабирование по потокам и размерам
+void task4Scaling();
+void taskStream(); // Потоковая статистика по файлу (mmap / чтение кусками)
+void taskRoofline(); // STREAM и точки roofline для редукций
 
 using namespace std;
 
@@ -18,6 +22,10 @@ int main() {
         cout << "2 - Task 2\n";
         cout << "3 - Task 3\n";
         cout << "4 - Task 4\n";
+        cout << "5 - Масштабирование min/max (Task 3)\n";
+        cout << "6 - Масштабирование среднего (Task 4)\n";
+        cout << "7 - Среднее и min/max по файлу (больше RAM)\n";
+        cout << "8 - Пропускная способность памяти (STREAM) и roofline\n";
         cout << "0 - Выход\n";
         cout << "Ввод: ";
         cin >> choice;
@@ -35,11 +43,23 @@ int main() {
         case 4:
             task4();
             break;
+        case 5:
+            task3Scaling();
+            break;
+        case 6:
+            task4Scaling();
+            break;
+        case 7:
+            taskStream();
+            break;
+        case 8:
+            taskRoofline();
+            break;
         case 0:
             cout << "Выход из программы.\n";
             return 0;
         default:
-            cout << "Ошибка: введите число от 0 до 4\n";
+            cout << "Ошибка: введите число от 0 до 8\n";
         }
     }
 }
@@ -0,0 +1,72 @@
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "../common/bench.h" // Замер времени: прогрев, повторы, CSV/JSON
+#include "../common/counter_rng.h" // Параллельный счётчиковый генератор
+#include "../common/kernels.h" // Общие шаблонные ядра редукций
+#include "../common/numa_buffer.h" // First-touch буфер и размещение по NUMA-узлам
+#include "../common/roofline.h" // STREAM и точки roofline
+
+using namespace std;
+
+// Совмещённый проход min/max/sum/mean (AVX2 + OpenMP), реализация в stats_fused.cpp
+void statsFusedOMP(const int* arr, int n, int& outMin, int& outMax, long long& outSum, double& outMean);
+
+// STREAM (copy/scale/add/triad, обычная и потоковая запись) и редукции заданий 3-4 на одной шкале:
+// байты, ГБ/с, % измеренного пика, флоп/байт. Массив редукций (2^25 int = 128 МБ) много больше L3,
+// поэтому измеряется именно память. Точки сохраняются в assignment1_roofline.csv/.json
+void taskRoofline() {
+    BenchConfig cfg = BenchConfig::fromEnv();
+    BenchReport report("assignment1_roofline");
+
+    const size_t streamN = streamSizeFromEnv();
+    cout << "[Roofline]\n";
+    cout << "STREAM: 3 массива по " << streamN << " double (" << streamN * sizeof(double) / (1 << 20) << " МБ)\n";
+    vector<StreamResult> stream = streamSuite(streamN, cfg);
+    const double peak = streamBest(stream);
+    report.setPeakGBps(peak);
+    printf("  %-10s %10s %10s %10s %8s %10s\n", "kernel", "MB", "ms", "GB/s", "% пика", "флоп/байт");
+    for (const StreamResult& r : stream) {
+        printf("  %-10s %10.1f %10.3f %10.2f %7.0f%% %10.3f\n", r.name.c_str(), r.traffic.bytes / 1e6,
+            r.st.ms(), r.gbPerSec(), 100.0 * r.gbPerSec() / peak, r.traffic.intensity());
+        report.add(r.st);
+    }
+    cout << "Пик памяти (лучший STREAM): " << peak << " GB/s\n";
+
+    // Редукции: каждое ядро читает массив один раз и ничего не пишет
+    const int SIZE = 1 << 25;
+    NumaBuffer<int> buf(SIZE, numaHugePagesFromEnv());
+    int* arr = buf.data();
+    counterFillInt(arr, SIZE, 0, RAND_MAX, 12345);
+
+    double avg = 0.0;
+    int mn = 0, mx = 0;
+    long long sum = 0;
+    struct Row { const char* name; double opsPerElem; BenchStats st; };
+    vector<Row> rows;
+    rows.push_back({"average_sequential", 1, benchRun("average_sequential", SIZE, cfg, [&]() {
+        avg = kernels::averageSequential(arr, (size_t)SIZE); })});
+    rows.push_back({"average_parallel", 1, benchRun("average_parallel", SIZE, cfg, [&]() {
+        avg = kernels::averageParallel(arr, (size_t)SIZE); })});
+    rows.push_back({"minmax_sequential", 2, benchRun("minmax_sequential", SIZE, cfg, [&]() {
+        kernels::minmaxSequential(arr, (size_t)SIZE, mn, mx); })});
+    rows.push_back({"minmax_parallel", 2, benchRun("minmax_parallel", SIZE, cfg, [&]() {
+        kernels::minmaxParallel(arr, (size_t)SIZE, mn, mx); })});
+    rows.push_back({"stats_fused_simd", 3, benchRun("stats_fused_simd", SIZE, cfg, [&]() {
+        statsFusedOMP(arr, SIZE, mn, mx, sum, avg); })});
+
+    cout << "\nРедукции по " << SIZE << " int (операций на элемент: сумма 1, min/max 2, fused 3):\n";
+    for (Row& r : rows) {
+        rooflineAttach(r.st, trafficFor<int>(SIZE, 1, 0, r.opsPerElem));
+        r.st.note = numaPlacement(arr, (size_t)SIZE * sizeof(int));
+        report.add(r.st);
+        printf("  %-20s %s, %s\n", r.name, benchBrief(r.st).c_str(), rooflineBrief(r.st, peak).c_str());
+    }
+    // Потолок roofline для интенсивности I: min(пик памяти × I, пик вычислений). У редукций I < 1,
+    // поэтому предел — наклонная часть: время не может быть меньше bytes / peak
+    cout << "Нижняя граница времени чтения " << (double)SIZE * sizeof(int) / 1e6 << " MB при "
+        << peak << " GB/s: " << (double)SIZE * sizeof(int) / peak / 1e6 << " ms\n";
+    report.save("assignment1_roofline");
+}
@@ -0,0 +1,94 @@
+#include <limits>  // numeric_limits для инициализации min/max
+#include <vector>
+#include <algorithm>
+
+#ifdef __AVX2__
+#include <immintrin.h> // AVX2 intrinsics (8 x int32 в одном регистре)
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
+
+// Частичный результат одного потока.
+// alignas(64) — каждый поток пишет в свою кэш-линию, нет false sharing
+struct alignas(64) StatsPartial {
+    int mn = numeric_limits<int>::max();
+    int mx = numeric_limits<int>::min();
+    long long sum = 0;
+};
+
+// Обработка участка [L, R): min, max и сумма за один проход по памяти
+static StatsPartial statsRange(const int* arr, int L, int R) {
+    StatsPartial p;
+    int i = L;
+#ifdef __AVX2__
+    // 8 элементов за итерацию: min/max без ветвлений, сумма в 64-битных ячейках (без переполнения)
+    __m256i vmn = _mm256_set1_epi32(p.mn);
+    __m256i vmx = _mm256_set1_epi32(p.mx);
+    __m256i vsumLo = _mm256_setzero_si256();
+    __m256i vsumHi = _mm256_setzero_si256();
+    for (; i + 8 <= R; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(arr + i));
+        vmn = _mm256_min_epi32(vmn, v);
+        vmx = _mm256_max_epi32(vmx, v);
+        vsumLo = _mm256_add_epi64(vsumLo, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        vsumHi = _mm256_add_epi64(vsumHi, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    // Горизонтальное объединение дорожек регистра
+    alignas(32) int lmn[8], lmx[8];
+    alignas(32) long long lsum[4];
+    _mm256_store_si256((__m256i*)lmn, vmn);
+    _mm256_store_si256((__m256i*)lmx, vmx);
+    _mm256_store_si256((__m256i*)lsum, _mm256_add_epi64(vsumLo, vsumHi));
+    for (int k = 0; k < 8; k++) {
+        p.mn = min(p.mn, lmn[k]);
+        p.mx = max(p.mx, lmx[k]);
+    }
+    p.sum = lsum[0] + lsum[1] + lsum[2] + lsum[3];
+#endif
+    // Скалярный хвост (или весь участок, если AVX2 недоступен): min/max без if
+    for (; i < R; i++) {
+        p.mn = min(p.mn, arr[i]);
+        p.mx = max(p.mx, arr[i]);
+        p.sum += arr[i];
+    }
+    return p;
+}
+
+// Совмещённое вычисление min, max, суммы и среднего за один проход (OpenMP + AVX2)
+// Каждый поток пишет свой частичный результат в отдельную ячейку,
+// объединение выполняется после параллельной области — без critical
+void statsFusedOMP(const int* arr, int n, int& outMin, int& outMax, long long& outSum, double& outMean) {
+    int T = 1;
+#ifdef _OPENMP
+    T = omp_get_max_threads();
+#endif
+    vector<StatsPartial> partial(T);
+#ifdef _OPENMP
+#pragma omp parallel num_threads(T)
+#endif
+    {
+        int tid = 0, nt = 1;
+#ifdef _OPENMP
+        tid = omp_get_thread_num();
+        nt = omp_get_num_threads();
+#endif
+        // Статическое разбиение на непрерывные куски — векторный цикл внутри куска
+        int L = (int)((long long)n * tid / nt);
+        int R = (int)((long long)n * (tid + 1) / nt);
+        partial[tid] = statsRange(arr, L, R);
+    }
+    StatsPartial total = partial[0];
+    for (int t = 1; t < T; t++) {
+        total.mn = min(total.mn, partial[t].mn);
+        total.mx = max(total.mx, partial[t].mx);
+        total.sum += partial[t].sum;
+    }
+    outMin = total.mn;
+    outMax = total.mx;
+    outSum = total.sum;
+    outMean = (n > 0) ? (double)total.sum / n : 0.0;
+}
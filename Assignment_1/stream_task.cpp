@@ -0,0 +1,71 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include "../common/stream_stats.h" // mmap / чтение кусками + OpenMP reduction
+
+using namespace std;
+
+// Печать результата одного прохода по файлу
+template <class T>
+static void printStream(const char* label, const StreamStats<T>& st) {
+    cout << label << " -> count: " << st.count
+        << ", avg: " << st.mean()
+        << ", min: " << st.mn
+        << ", max: " << st.mx
+        << ", time: " << st.seconds * 1000.0 << " ms"
+        << ", " << st.gbPerSec() << " GB/s\n";
+}
+
+// Среднее и min/max по файлу в двух режимах: mmap и чтение выровненными кусками
+template <class T>
+static void runStream(const string& path) {
+    StreamStats<T> viaMmap, viaRead;
+    if (!streamStatsFile(path, viaMmap, StreamMode::Mmap) ||
+        !streamStatsFile(path, viaRead, StreamMode::Read)) {
+        cout << "Ошибка: не удалось прочитать файл " << path << "\n";
+        return;
+    }
+    printStream("mmap", viaMmap);
+    printStream("read", viaRead);
+    // Суммы собираются OpenMP-редукцией в произвольном порядке, поэтому у float64 они могут
+    // отличаться в последних битах; сравниваем с относительным допуском
+    const double sumDiff = fabs((double)viaMmap.sum - (double)viaRead.sum);
+    const bool sumOk = sumDiff <= 1e-9 * max(1.0, fabs((double)viaMmap.sum));
+    if (sumOk && viaMmap.count == viaRead.count && viaMmap.mn == viaRead.mn && viaMmap.mx == viaRead.mx) {
+        cout << "Проверка: OK (режимы совпадают)\n";}
+    else {
+        cout << "Проверка: WARNING (режимы дали разный результат)\n";}
+}
+
+// Потоковая обработка файлов больше оперативной памяти (int32 / float64)
+void taskStream() {
+    cout << "[Stream]\n";
+    cout << "Тип элементов: 1 - int32, 2 - float64: ";
+    int type = 1;
+    cin >> type;
+    cout << "Путь к бинарному файлу: ";
+    string path;
+    cin >> path;
+
+    // Если файла нет — можно создать тестовый, не держа его в памяти целиком
+    FILE* probe = fopen(path.c_str(), "rb");
+    if (probe) {
+        fclose(probe);}
+    else {
+        cout << "Файл не найден. Создать тестовый файл из N элементов (0 — нет): ";
+        long long n = 0;
+        cin >> n;
+        if (n <= 0) return;
+        bool ok = (type == 2)
+            ? streamWriteTestFile<double>(path, n, [](long long i) { return (double)(i % 1000) / 10.0; })
+            : streamWriteTestFile<int>(path, n, [](long long i) { return (int)(i % 100) + 1; });
+        if (!ok) {
+            cout << "Ошибка: не удалось создать файл\n";
+            return;}
+    }
+
+    if (type == 2) runStream<double>(path);
+    else runStream<int>(path);
+}
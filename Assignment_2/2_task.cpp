@@ -1,8 +1,10 @@
 #include <iostream>        // Для ввода-вывода (cout)
 #include <vector>          // Для использования std::vector
-#include <random>          // Для генерации случайных чисел
 #include <chrono>          // Для измерения времени выполнения
 #include <omp.h>           // Для работы с OpenMP
+#include "../common/counter_rng.h" // Параллельный счётчиковый генератор
+#include "../common/perf_counters.h" // Счётчики perf: IPC, промахи переходов и кэша
+#include "../common/roofline.h" // Байты, ГБ/с, % пика STREAM, флоп/байт
 
 using namespace std;
 
@@ -12,42 +14,54 @@ void task2() {
     const int N = 10000;   // Размер массива
     vector<int> arr(N);    // Создаём массив из 10 000 элементов
 
-    // Генерация случайных чисел
-    mt19937 rng(42);       // Генератор случайных чисел (фиксированный seed)
-    uniform_int_distribution<int> dist(0, 100000); // Диапазон чисел
-
-    for (int i = 0; i < N; i++) {
-        arr[i] = dist(rng);    // Заполняем массив случайными числами
-    }
+    // Генерация случайных чисел: элемент i зависит только от (seed, i),
+    // поэтому заполнение параллельное и одинаковое при любом числе потоков
+    counterFillInt(arr.data(), N, 0, 100000, 42); // Фиксированный seed, диапазон 0..100000
 
     // Последовательный поиск min/max
     int min_seq = arr[0];  // Минимум (последовательно)
     int max_seq = arr[0];  // Максимум (последовательно)
 
-    auto start_seq = chrono::high_resolution_clock::now(); // Старт таймера
+    // Счётчики perf обоих проходов (пусто, если недоступны). Открываются до старта таймера
+    PerfCounts perf_seq, perf_par;
+    double time_seq = 0.0;
+    {
+        PerfScope scope(perf_seq); // Ветвистые сравнения: видно по промахам предсказания переходов
+        auto start_seq = chrono::high_resolution_clock::now(); // Старт таймера
 
-    for (int i = 1; i < N; i++) {
-        if (arr[i] < min_seq) min_seq = arr[i]; // Проверка минимума
-        if (arr[i] > max_seq) max_seq = arr[i]; // Проверка максимума
-    }
+        for (int i = 1; i < N; i++) {
+            if (arr[i] < min_seq) min_seq = arr[i]; // Проверка минимума
+            if (arr[i] > max_seq) max_seq = arr[i]; // Проверка максимума
+        }
 
-    auto end_seq = chrono::high_resolution_clock::now();   // Конец таймера
-    double time_seq = chrono::duration<double, milli>(end_seq - start_seq).count();
+        auto end_seq = chrono::high_resolution_clock::now();   // Конец таймера
+        time_seq = chrono::duration<double, milli>(end_seq - start_seq).count();
+    }
     // Параллельный поиск min/max (OpenMP)
 
     int min_par = arr[0];  // Минимум (параллельно)
     int max_par = arr[0];  // Максимум (параллельно)
 
-    auto start_par = chrono::high_resolution_clock::now(); // Старт таймера
+    double time_par = 0.0;
+    {
+        PerfScope scope(perf_par); // Сумма по всем потокам OpenMP
+        auto start_par = chrono::high_resolution_clock::now(); // Старт таймера
 
 #pragma omp parallel for reduction(min:min_par) reduction(max:max_par)
-    for (int i = 0; i < N; i++) {
-        if (arr[i] < min_par) min_par = arr[i]; // Каждый поток ищет минимум
-        if (arr[i] > max_par) max_par = arr[i]; // Каждый поток ищет максимум
+        for (int i = 0; i < N; i++) {
+            if (arr[i] < min_par) min_par = arr[i]; // Каждый поток ищет минимум
+            if (arr[i] > max_par) max_par = arr[i]; // Каждый поток ищет максимум
+        }
+
+        auto end_par = chrono::high_resolution_clock::now();   // Конец таймера
+        time_par = chrono::duration<double, milli>(end_par - start_par).count();
     }
 
-    auto end_par = chrono::high_resolution_clock::now();   // Конец таймера
-    double time_par = chrono::duration<double, milli>(end_par - start_par).count();
+    // Каждый проход читает массив один раз: 4 байта и 2 сравнения на элемент. 40 КБ лежат в кэше,
+    // а один проход длится микросекунды (и включает запуск команды потоков), так что % пика STREAM
+    // здесь — ориентир, а не предел: упор не в память
+    const Traffic traffic = trafficFor<int>(N, 1, 0, 2);
+    const double peak = hostPeakBandwidth();
 
     // Вывод результатов
     cout << "\n Task 2: Min/Max + OpenMP \n";
@@ -55,12 +69,18 @@ void task2() {
     cout << "Последовательная версия:\n";
     cout << "  Min = " << min_seq << "\n";
     cout << "  Max = " << max_seq << "\n";
-    cout << "  Time = " << time_seq << " ms\n\n";
+    cout << "  Time = " << time_seq << " ms\n";
+    cout << "  Traffic = " << rooflineBrief(time_seq * 1e6, traffic, peak) << "\n";
+    if (perf_seq.any()) cout << "  Perf = " << perfBrief(perf_seq) << "\n";
+    cout << "\n";
 
     cout << "Параллельная версия (OpenMP):\n";
     cout << "  Min = " << min_par << "\n";
     cout << "  Max = " << max_par << "\n";
-    cout << "  Time = " << time_par << " ms\n\n";
+    cout << "  Time = " << time_par << " ms\n";
+    cout << "  Traffic = " << rooflineBrief(time_par * 1e6, traffic, peak) << "\n";
+    if (perf_par.any()) cout << "  Perf = " << perfBrief(perf_par) << "\n";
+    cout << "\n";
 
     // Проверка корректности
     if (min_seq == min_par && max_seq == max_par) {
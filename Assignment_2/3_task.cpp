@@ -1,9 +1,13 @@
 #include <iostream>        // cout, endl
 #include <vector>          // vector
-#include <random>          // mt19937, uniform_int_distribution
-#include <chrono>          // измерение времени
 #include <algorithm>       // is_sorted
 #include <omp.h>           // OpenMP
+#include "../common/tournament_tree.h" // Турнирное дерево (loser tree)
+#include "../common/bench.h"   // Общий замер времени: прогрев, повторы, CSV/JSON
+#include "../common/scaling.h" // Перебор потоков и размеров
+#include "../common/counter_rng.h" // Параллельный счётчиковый генератор
+#include "../common/kernels.h" // Общие шаблонные ядра сортировок
+#include "../common/topk.h" // Параллельный top-k и n-й элемент (значение + индекс)
 
 using namespace std;
 
@@ -21,24 +25,13 @@ struct MinPair {           // Структура "минимум + позици
 // Генерация массива
 static vector<int> make_random_array(int n) {                // Функция создаёт рандомный массив
     vector<int> a(n);                                       // Выделяем память под массив
-    mt19937 rng(42);                                        // Генератор с фиксированным seed
-    uniform_int_distribution<int> dist(-100000, 100000);    // Диапазон чисел
-    for (int i = 0; i < n; i++) {                           // Идём по всем элементам
-        a[i] = dist(rng);                                   // Заполняем случайным числом
-    }
+    counterFillInt(a.data(), n, -100000, 100000, 42);       // Параллельно, фиксированный seed
     return a;                                               // Возвращаем массив
 }
 
 // Последовательная сортировка выбором
 static void selection_sort_sequential(vector<int>& a) {      // Обычный selection sort
-    int n = (int)a.size();                                  // Размер массива
-    for (int i = 0; i < n - 1; i++) {                        // Шагаем по позициям
-        int bestIdx = i;                                    // Считаем, что минимум — в i
-        for (int j = i + 1; j < n; j++) {                    // Ищем минимум справа
-            if (a[j] < a[bestIdx]) bestIdx = j;              // Обновляем индекс минимума
-        }
-        if (bestIdx != i) swap(a[i], a[bestIdx]);            // Ставим минимум на позицию i
-    }
+    kernels::selectionSortSeq(a.data(), a.size());          // Общее шаблонное ядро
 }
 
 // Параллельная сортировка выбором (OpenMP)
@@ -63,19 +56,51 @@ static void selection_sort_parallel(vector<int>& a) {        // Параллел
     }
 }
 
-// Измерение времени для одной функции сортировки
+// Трафик сортировки выбором: поиск минимума читает хвост a[i+1..n), всего n(n-1)/2 элементов
+// и столько же сравнений (обмены — O(n), не считаем)
+static Traffic selection_traffic(long long n) {
+    Traffic t;
+    t.flops = (double)n * (n - 1) / 2;
+    t.bytes = t.flops * sizeof(int);
+    return t;
+}
+
+// Измерение времени для одной функции сортировки (прогрев + повторы, см. common/bench.h)
+// Перед каждым повтором a восстанавливается из base, копирование в замер не входит.
+// traffic — модель трафика, если она есть; иначе байты в отчёте остаются пустыми
 template <typename Func>
-static double measure_ms(Func f) {                           // Шаблон для измерения времени
-    auto start = chrono::high_resolution_clock::now();        // Старт
-    f();                                                     // Выполнение
-    auto end = chrono::high_resolution_clock::now();          // Конец
-    return chrono::duration<double, milli>(end - start).count(); // Время в мс
+static BenchStats measure_sort(BenchReport& report, const char* name,
+                               const vector<int>& base, vector<int>& a, Func f,
+                               Traffic traffic = Traffic()) {
+    BenchStats st = benchRun(name, (long long)base.size(), BenchConfig::fromEnv(),
+        [&]() { a = base; },                                 // Подготовка (не замеряется)
+        [&]() { f(a); });                                    // Сортировка
+    rooflineAttach(st, traffic);
+    report.add(st);                                          // В общий отчёт
+    return st;
+}
+
+// Режим масштабирования параллельной сортировки выбором (O(n^2), поэтому N до 10^4)
+void task3Scaling() {
+    vector<int> base, a;                                     // Исходный массив и рабочая копия
+    ScalingKernel k;
+    k.name = "selection_sort_parallel";
+    k.prepare = [&](long long n) { base = make_random_array((int)n); };
+    k.reset = [&]() { a = base; };                           // Сортировка портит вход
+    k.run = [&]() { selection_sort_parallel(a); };
+    BenchReport report("assignment2_task3_scaling");
+    auto points = scalingSweep(k, scalingDecades(1000, 10000), 2000, report);
+    scalingWriteCsv("assignment2_task3_scaling.csv", k.name, points);
+    report.save("assignment2_task3_scaling_raw");
 }
 
 // TASK 3 (вызывается из main.cpp)
 void task3() {
 
     cout << "\nTask 3: Selection Sort + OpenMP\n";     // Заголовок
+    BenchReport report("assignment2_task3");                 // Отчёт для CSV/JSON
+    const double peak = hostPeakBandwidth();                 // Пик STREAM (ГБ/с)
+    report.setPeakGBps(peak);
 
     // Проверяем два размера
     const int sizes[2] = { 1000, 10000 };                     // Размеры массивов
@@ -86,33 +111,174 @@ void task3() {
 
         vector<int> base = make_random_array(N);               // Базовый (одинаковый) массив
 
-        vector<int> a1 = base;                                 // Копия для последовательной сортировки
-        vector<int> a2 = base;                                 // Копия для параллельной сортировки
-
-        double t_seq = measure_ms([&]() {                      // Замер времени последовательной
-            selection_sort_sequential(a1);                     // Сортировка
-            });
+        vector<int> a1, a2, a3;                                // Массивы для трёх версий
 
-        double t_par = measure_ms([&]() {                      // Замер времени параллельной
-            selection_sort_parallel(a2);                       // Сортировка
-            });
+        BenchStats s_seq = measure_sort(report, "selection_sequential", base, a1,
+            selection_sort_sequential, selection_traffic(N));  // Последовательная
+        BenchStats s_par = measure_sort(report, "selection_parallel", base, a2,
+            selection_sort_parallel, selection_traffic(N));    // Параллельная
+        BenchStats s_tree = measure_sort(report, "selection_tournament", base, a3,
+            tournamentSelectionSort<int>);                     // Построение один раз + n извлечений
+        double t_seq = s_seq.ms();                             // Медианы в мс
+        double t_par = s_par.ms();
+        double t_tree = s_tree.ms();
 
         bool ok1 = is_sorted(a1.begin(), a1.end());            // Проверка: отсортирован ли a1
         bool ok2 = is_sorted(a2.begin(), a2.end());            // Проверка: отсортирован ли a2
-        bool same = (a1 == a2);                                // Проверка: одинаковый результат
+        bool ok3 = is_sorted(a3.begin(), a3.end());            // Проверка: отсортирован ли a3
+        bool same = (a1 == a2) && (a1 == a3);                  // Проверка: одинаковый результат
 
         cout << "Sequential Selection Sort:\n";                // Подпись
-        cout << "  time = " << t_seq << " ms\n";               // Время
+        cout << "  time = " << benchBrief(s_seq) << "\n";      // Время
+        cout << "  traffic = " << rooflineBrief(s_seq, peak) << "\n"; // Трафик поиска минимумов
 
         cout << "OpenMP Parallel Selection Sort:\n";           // Подпись
-        cout << "  time = " << t_par << " ms\n";               // Время
+        cout << "  time = " << benchBrief(s_par) << "\n";      // Время
+        cout << "  traffic = " << rooflineBrief(s_par, peak) << "\n"; // Трафик поиска минимумов
 
-        cout << "Correct (sorted): " << ((ok1 && ok2) ? "YES" : "NO") << "\n"; // Корректность
+        cout << "Tournament Tree Selection Sort:\n";           // Подпись
+        cout << "  time = " << benchBrief(s_tree) << "\n";     // Время
+
+        cout << "Correct (sorted): " << ((ok1 && ok2 && ok3) ? "YES" : "NO") << "\n"; // Корректность
         cout << "Same result: " << (same ? "YES" : "NO") << "\n";              // Совпадение
 
         if (t_par > 0.0) {                                     // Чтобы не делить на 0
             cout << "Speedup (seq/par): " << (t_seq / t_par) << "x\n"; // Ускорение
         }
+        if (t_tree > 0.0) {                                    // Чтобы не делить на 0
+            cout << "Speedup (seq/tree): " << (t_seq / t_tree) << "x\n"; // Ускорение дерева
+        }
+    }
+
+    // Квадратичные версии на таких размерах не дождаться — запускаем только дерево
+    const int bigSizes[2] = { 1000000, 10000000 };           // Большие размеры
+    for (int s = 0; s < 2; s++) {                              // Перебор размеров
+        int N = bigSizes[s];                                   // Текущий размер
+        vector<int> base = make_random_array(N);               // Массив
+        vector<int> a;
+        BenchStats s_tree = measure_sort(report, "selection_tournament", base, a,
+            tournamentSelectionSort<int>);                     // Сортировка
+        cout << "\nN = " << N << "\n";                          // Печать размера
+        cout << "Tournament Tree Selection Sort:\n";           // Подпись
+        cout << "  time = " << benchBrief(s_tree) << "\n";     // Время
+        cout << "Correct (sorted): " << (is_sorted(a.begin(), a.end()) ? "YES" : "NO") << "\n";
+    }
+
+    report.save("assignment2_task3");                         // assignment2_task3.csv / .json
+
+}
+
+// Порядок ответа top-k: по значению (по убыванию для наибольших), равные — по индексу
+template <class T>
+static bool topk_before(bool largest, T v1, size_t i1, T v2, size_t i2) {
+    if (v1 != v2) return largest ? v2 < v1 : v1 < v2;
+    return i1 < i2;
+}
+
+// Ранг пары в этом порядке + 1: сколько элементов массива не позже неё
+template <class T>
+static size_t topk_rank(const vector<T>& a, const RankedValue<T>& x, bool largest) {
+    size_t notAfter = 0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+:notAfter)
+#endif
+    for (long long j = 0; j < (long long)a.size(); j++)
+        notAfter += !topk_before(largest, x.value, x.index, a[j], (size_t)j);
+    return notAfter;
+}
+
+// Проверка ответа top-k за O(n): пары упорядочены, значения совпадают с массивом,
+// и ровно k элементов массива не позже последней пары ответа
+template <class T>
+static bool topk_valid(const vector<T>& a, const vector<RankedValue<T>>& r, size_t k, bool largest) {
+    if (r.size() != k) return false;
+    for (size_t i = 0; i < k; i++) {
+        if (r[i].index >= a.size() || a[r[i].index] != r[i].value) return false;
+        if (i > 0 && !topk_before(largest, r[i - 1].value, r[i - 1].index, r[i].value, r[i].index)) return false;
     }
+    return topk_rank(a, r.back(), largest) == k;
+}
+
+// Трафик top-k известен только снизу: вход читается хотя бы один раз, а число следующих проходов
+// по кандидатам зависит от k и данных. ГБ/с по этой оценке — эффективная пропускная способность
+template <class T>
+static void topk_attach_traffic(BenchStats& st, long long n) {
+    rooflineAttach(st, trafficFor<T>(n, 1, 0, 0));
+    st.note = "bytes: нижняя оценка (одно чтение входа)";
+}
+
+// Top-k и n-й элемент вместо полной сортировки выбором: k наименьших/наибольших пар (значение, индекс)
+// на 10^8 элементов при k от 1 до n/2, сравнение с полной сортировкой пар (std::sort)
+void task3TopK() {
+    cout << "\nTask 3: Top-k / n-й элемент + OpenMP, потоков: " << topk_detail::maxThreads() << "\n";
+    BenchReport report("assignment2_topk");                  // Отчёт для CSV/JSON
+    const double peak = hostPeakBandwidth();                 // Пик STREAM (ГБ/с)
+    report.setPeakGBps(peak);
+    BenchConfig cfg = BenchConfig::fromEnv();
+    cfg.reps = min(cfg.reps, 3);                             // Один запуск на 10^8 — секунды
+
+    const int N = 100000000;                                 // 10^8 элементов
+    vector<int> a = make_random_array(N);                    // Значения -10^5..10^5: много повторов
+    cout << "N = " << N << "\n";
+
+    const size_t ks[] = { 1, 100, 10000, 1000000, (size_t)N / 2 };
+    for (size_t k : ks) {
+        vector<RankedValue<int>> small, large;
+        BenchStats st = benchRun("topk_smallest_k" + to_string(k), N, cfg,
+            [&]() { small = topkSmallest(a.data(), a.size(), k); });
+        BenchStats sl = benchRun("topk_largest_k" + to_string(k), N, cfg,
+            [&]() { large = topkLargest(a.data(), a.size(), k); });
+        topk_attach_traffic<int>(st, N);
+        topk_attach_traffic<int>(sl, N);
+        report.add(st);
+        report.add(sl);
+        const bool ok = topk_valid(a, small, k, false) && topk_valid(a, large, k, true);
+        cout << "k = " << k << ": smallest " << benchBrief(st) << "; " << rooflineBrief(st, peak) << "\n"
+             << string(to_string(k).size() + 6, ' ') << "largest  " << benchBrief(sl) << "; "
+             << rooflineBrief(sl, peak) << " -> " << (ok ? "OK" : "ОШИБКА") << "\n";
+    }
+
+    // n-й элемент (медиана) без сортировки остальных
+    RankedValue<int> med{};
+    BenchStats sm = benchRun("nth_element_median", N, cfg,
+        [&]() { med = nthElement(a.data(), a.size(), (size_t)N / 2); });
+    topk_attach_traffic<int>(sm, N);
+    report.add(sm);
+    const bool medOk = a[med.index] == med.value && topk_rank(a, med, false) == (size_t)N / 2 + 1;
+    cout << "Медиана: a[" << med.index << "] = " << med.value << ", " << benchBrief(sm)
+         << "; " << rooflineBrief(sm, peak) << " -> " << (medOk ? "OK" : "ОШИБКА") << "\n";
+
+    // Вещественный массив (10^7 float в [0, 1))
+    vector<float> f(N / 10);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (long long i = 0; i < (long long)f.size(); i++) f[i] = (float)counterUniform01(7, (uint64_t)i);
+    vector<RankedValue<float>> fr;
+    BenchStats sf = benchRun("topk_largest_float_k1000", (long long)f.size(), cfg,
+        [&]() { fr = topkLargest(f.data(), f.size(), 1000); });
+    topk_attach_traffic<float>(sf, (long long)f.size());
+    report.add(sf);
+    cout << "float, N = " << f.size() << ", k = 1000 наибольших: " << benchBrief(sf) << "; "
+         << rooflineBrief(sf, peak) << " -> "
+         << (topk_valid(f, fr, 1000, true) ? "OK" : "ОШИБКА") << "\n";
+
+    // Эталон: полная сортировка пар — то, без чего top-k обходится
+    BenchConfig once = cfg;
+    once.warmup = 0;
+    once.reps = 1;
+    vector<RankedValue<int>> all;
+    BenchStats ss = benchRun("full_sort_pairs", N, once, [&]() {
+        all.resize(a.size());
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (long long i = 0; i < (long long)a.size(); i++) all[i] = { a[i], (size_t)i };
+        sort(all.begin(), all.end(), [](const RankedValue<int>& x, const RankedValue<int>& y) {
+            return x.value != y.value ? x.value < y.value : x.index < y.index; });
+    });
+    report.add(ss);
+    cout << "Полная сортировка пар (std::sort): " << benchBrief(ss) << "\n";
 
+    report.save("assignment2_topk");                         // assignment2_topk.csv / .json
 }
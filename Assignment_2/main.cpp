@@ -3,6 +3,8 @@
 
 void task2();// Эти функции реализуют логику каждого отдельного задания
 void task3();
+void task3Scaling(); // Масштабирование по потокам и размерам
+void task3TopK();    // Top-k и n-й элемент без полной сортировки
 
 using namespace std;
 
@@ -14,6 +16,8 @@ int main() {
         cout << "\nВыберите задание для запуска:\n";
         cout << "1 - Task 2\n";
         cout << "2 - Task 3\n";
+        cout << "4 - Масштабирование (Task 3)\n";
+        cout << "5 - Top-k / n-й элемент (Task 3)\n";
         cout << "0 - Выход\n";
         cout << "Ввод: ";
         cin >> choice;
@@ -25,11 +29,17 @@ int main() {
         case 3:
             task3();
             break;
+        case 4:
+            task3Scaling();
+            break;
+        case 5:
+            task3TopK();
+            break;
         case 0:
             cout << "Выход из программы.\n";
             return 0;
         default:
-            cout << "Ошибка: введите число от 0 до 4\n";
+            cout << "Ошибка: введите число от 0 до 5\n";
         }
     }
 }
@@ -0,0 +1,278 @@
+#pragma once // Защита от многократного включения файла
+
+// Общий замер времени для всех задач: прогрев, N повторов, статистика в наносекундах
+// (медиана, p5, p95, среднее, стандартное отклонение) и выгрузка в CSV/JSON.
+// Повторы можно переопределить без пересборки: BENCH_WARMUP, BENCH_REPS, BENCH_MAX_SEC.
+// Вокруг каждого замеряемого запуска работают счётчики perf (common/perf_counters.h):
+// IPC и промахи на запуск попадают в BenchStats, в консоль и в CSV/JSON (BENCH_PERF=0 — выключить).
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "perf_counters.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+struct BenchConfig {
+    int warmup = 1;          // Прогревочные запуски (не входят в статистику)
+    int reps = 5;            // Максимум замеряемых повторов
+    double maxSeconds = 10;  // Бюджет времени: после него повторы прекращаются (минимум один замер)
+
+    // Значения по умолчанию с учётом переменных окружения
+    static BenchConfig fromEnv() {
+        BenchConfig c;
+        if (const char* s = std::getenv("BENCH_WARMUP")) c.warmup = std::max(0, std::atoi(s));
+        if (const char* s = std::getenv("BENCH_REPS")) c.reps = std::max(1, std::atoi(s));
+        if (const char* s = std::getenv("BENCH_MAX_SEC")) c.maxSeconds = std::atof(s);
+        return c;
+    }
+};
+
+struct BenchStats {
+    std::string name;  // Название замера
+    long long n = 0;   // Размер задачи (элементов)
+    int reps = 0;      // Сколько повторов реально выполнено
+    int threads = 1;   // Число потоков OpenMP во время замера
+    std::string note;  // Произвольная пометка (например, размещение страниц по NUMA-узлам)
+    double minNs = 0, medianNs = 0, p5Ns = 0, p95Ns = 0, meanNs = 0, stddevNs = 0;
+    double bytes = 0;  // Трафик памяти одного запуска (0 — не задан), см. common/roofline.h
+    double flops = 0;  // Арифметических операций одного запуска
+    PerfCounts perf;   // Счётчики perf на один запуск (среднее по замеренным повторам)
+
+    double ms() const { return medianNs / 1e6; } // Медиана в миллисекундах — для вывода в консоль
+    double gbPerSec(double b) const { return medianNs > 0 ? b / medianNs : 0.0; } // байт/нс = ГБ/с
+    double gbPerSec() const { return gbPerSec(bytes); }
+    double flopPerByte() const { return bytes > 0 ? flops / bytes : 0.0; }
+};
+
+// Короткая строка для консоли: "медиана ms [p5..p95], повторов", затем IPC и промахи, если доступны
+inline std::string benchBrief(const BenchStats& st) {
+    char buf[128];
+    std::snprintf(buf, sizeof(buf), "%.3f ms [p5 %.3f .. p95 %.3f], reps %d",
+        st.medianNs / 1e6, st.p5Ns / 1e6, st.p95Ns / 1e6, st.reps);
+    const std::string perf = perfBrief(st.perf);
+    return perf.empty() ? std::string(buf) : buf + (", " + perf);
+}
+
+// Перцентиль по отсортированной выборке (линейная интерполяция)
+inline double benchPercentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    double pos = p * (sorted.size() - 1);
+    size_t lo = (size_t)pos;
+    size_t hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * (pos - lo);
+}
+
+inline BenchStats benchSummarize(const std::string& name, long long n, std::vector<double> samples) {
+    BenchStats st;
+    st.name = name;
+    st.n = n;
+    st.reps = (int)samples.size();
+    if (samples.empty()) return st;
+    std::sort(samples.begin(), samples.end());
+    st.minNs = samples.front();
+    st.medianNs = benchPercentile(samples, 0.50);
+    st.p5Ns = benchPercentile(samples, 0.05);
+    st.p95Ns = benchPercentile(samples, 0.95);
+    double sum = 0;
+    for (double x : samples) sum += x;
+    st.meanNs = sum / samples.size();
+    double var = 0;
+    for (double x : samples) var += (x - st.meanNs) * (x - st.meanNs);
+    st.stddevNs = samples.size() > 1 ? std::sqrt(var / (samples.size() - 1)) : 0.0;
+    return st;
+}
+
+// Замер функции f. setup() выполняется перед каждым запуском и в время не входит
+// (например, копирование исходного массива перед сортировкой)
+template <class Setup, class Func>
+BenchStats benchRun(const std::string& name, long long n, const BenchConfig& cfg, Setup setup, Func f) {
+    using clock = std::chrono::steady_clock;
+    std::vector<double> samples;
+    double spentNs = 0;
+    const double budgetNs = cfg.maxSeconds * 1e9;
+    PerfSession perf;   // Счётчики открываются один раз на серию, включаются только вокруг f()
+    int perfRuns = 0;
+    for (int r = 0; r < cfg.warmup + cfg.reps; r++) {
+        // Бюджет исчерпан — остаёмся с тем, что есть (но хотя бы один замер делаем)
+        if (spentNs > budgetNs && !samples.empty()) break;
+        setup();
+        const bool counted = r >= cfg.warmup;
+        if (counted) perf.start();
+        auto t0 = clock::now();
+        f();
+        auto t1 = clock::now();
+        if (counted) { perf.stop(); perfRuns++; }
+        double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+        spentNs += ns;
+        // Прогрев пропускаем только если после него ещё есть время на замер
+        if (r >= cfg.warmup || spentNs > budgetNs) samples.push_back(ns);
+    }
+    BenchStats st = benchSummarize(name, n, samples);
+    if (perfRuns > 0) {
+        st.perf = perf.read();
+        st.perf.divide(perfRuns);
+    }
+#ifdef _OPENMP
+    st.threads = omp_get_max_threads();
+#endif
+    return st;
+}
+
+template <class Func>
+BenchStats benchRun(const std::string& name, long long n, const BenchConfig& cfg, Func f) {
+    return benchRun(name, n, cfg, [] {}, f);
+}
+
+// Накопитель результатов одного запуска программы с выгрузкой в CSV/JSON
+class BenchReport {
+public:
+    explicit BenchReport(const std::string& suite) : suite_(suite) {}
+
+    void add(const BenchStats& st) { rows_.push_back(st); }
+
+    // Измеренный пик памяти (ГБ/с) — для столбца "% пика" в отчёте
+    void setPeakGBps(double gbps) { peakGBps_ = gbps; }
+
+    const std::vector<BenchStats>& rows() const { return rows_; }
+
+    bool writeCsv(const std::string& path) const {
+        std::ofstream out(path);
+        if (!out) return false;
+        out << "suite,name,n,reps,threads,median_ns,p5_ns,p95_ns,mean_ns,stddev_ns,min_ns,"
+            << "bytes,gb_per_s,pct_peak,flops,flop_per_byte,";
+        for (int e = 0; e < kPerfEventCount; e++) out << perfEventName(e) << ",";
+        out << "ipc,note\n";
+        for (const BenchStats& r : rows_) {
+            out << csvField(suite_) << "," << csvField(r.name) << "," << r.n << "," << r.reps << "," << r.threads << ","
+                << (long long)r.medianNs << "," << (long long)r.p5Ns << "," << (long long)r.p95Ns << ","
+                << (long long)r.meanNs << "," << (long long)r.stddevNs << "," << (long long)r.minNs << ",";
+            // Трафик не задан (bytes = 0) — пустые поля, а не нули, похожие на измерение
+            if (r.bytes > 0)
+                out << (long long)r.bytes << "," << r.gbPerSec() << ","
+                    << (peakGBps_ > 0 ? std::to_string(pctPeak(r)) : "") << ","
+                    << (long long)r.flops << "," << r.flopPerByte() << ",";
+            else out << ",,,,,";
+            // Недоступное событие — пустое поле
+            for (int e = 0; e < kPerfEventCount; e++) {
+                if (r.perf.valid[e]) out << (long long)r.perf.value[e];
+                out << ",";
+            }
+            if (r.perf.ipc() > 0) out << r.perf.ipc();
+            out << "," << csvField(r.note) << "\n";
+        }
+        return true;
+    }
+
+    bool writeJson(const std::string& path) const {
+        std::ofstream out(path);
+        if (!out) return false;
+        out << "{\n";
+        out << "  \"suite\": " << jsonString(suite_) << ",\n";
+        out << "  \"timestamp\": " << (long long)std::time(nullptr) << ",\n";
+        out << "  \"compiler\": " << jsonString(compiler()) << ",\n";
+        out << "  \"threads\": " << threads() << ",\n";
+        out << "  \"peak_gb_per_s\": " << peakGBps_ << ",\n";
+        out << "  \"results\": [\n";
+        for (size_t i = 0; i < rows_.size(); i++) {
+            const BenchStats& r = rows_[i];
+            out << "    {\"name\": " << jsonString(r.name) << ", \"n\": " << r.n << ", \"reps\": " << r.reps
+                << ", \"threads\": " << r.threads
+                << ", \"median_ns\": " << (long long)r.medianNs << ", \"p5_ns\": " << (long long)r.p5Ns
+                << ", \"p95_ns\": " << (long long)r.p95Ns << ", \"mean_ns\": " << (long long)r.meanNs
+                << ", \"stddev_ns\": " << (long long)r.stddevNs << ", \"min_ns\": " << (long long)r.minNs;
+            if (r.bytes > 0)
+                out << ", \"bytes\": " << (long long)r.bytes << ", \"gb_per_s\": " << r.gbPerSec()
+                    << ", \"pct_peak\": " << (peakGBps_ > 0 ? std::to_string(pctPeak(r)) : "null")
+                    << ", \"flops\": " << (long long)r.flops
+                    << ", \"flop_per_byte\": " << r.flopPerByte();
+            else
+                out << ", \"bytes\": null, \"gb_per_s\": null, \"pct_peak\": null, \"flops\": null"
+                    << ", \"flop_per_byte\": null";
+            for (int e = 0; e < kPerfEventCount; e++) {
+                out << ", \"" << perfEventName(e) << "\": ";
+                if (r.perf.valid[e]) out << (long long)r.perf.value[e];
+                else out << "null";
+            }
+            out << ", \"ipc\": ";
+            if (r.perf.ipc() > 0) out << r.perf.ipc();
+            else out << "null";
+            out << ", \"note\": " << jsonString(r.note) << "}"
+                << (i + 1 < rows_.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n}\n";
+        return true;
+    }
+
+    // Запись обоих файлов: <prefix>.csv и <prefix>.json
+    void save(const std::string& prefix) const {
+        writeCsv(prefix + ".csv");
+        writeJson(prefix + ".json");
+    }
+
+private:
+    // Поле CSV в кавычках (RFC 4180): кавычки внутри удваиваются, запятые и переводы строк безопасны
+    static std::string csvField(const std::string& s) {
+        std::string q = "\"";
+        for (char c : s) {
+            if (c == '"') q += '"';
+            q += c;
+        }
+        return q + "\"";
+    }
+
+    // Строка JSON в кавычках: экранируются кавычки, обратная косая черта и управляющие символы
+    static std::string jsonString(const std::string& s) {
+        std::string q = "\"";
+        for (char c : s) {
+            if (c == '"' || c == '\\') {
+                q += '\\';
+                q += c;
+            }
+            else if (c == '\n') q += "\\n";
+            else if (c == '\t') q += "\\t";
+            else if ((unsigned char)c < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", (unsigned)(unsigned char)c);
+                q += buf;
+            }
+            else q += c;
+        }
+        return q + "\"";
+    }
+
+    double pctPeak(const BenchStats& r) const { return peakGBps_ > 0 ? 100.0 * r.gbPerSec() / peakGBps_ : 0.0; }
+
+    static int threads() {
+#ifdef _OPENMP
+        return omp_get_max_threads();
+#else
+        return 1;
+#endif
+    }
+
+    static const char* compiler() {
+#if defined(__clang__)
+        return "clang " __clang_version__;
+#elif defined(__GNUC__)
+        return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+        return "msvc";
+#else
+        return "unknown";
+#endif
+    }
+
+    std::string suite_;
+    std::vector<BenchStats> rows_;
+    double peakGBps_ = 0;
+};
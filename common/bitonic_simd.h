@@ -0,0 +1,281 @@
+#pragma once // Защита от многократного включения файла
+
+// Битонная сортирующая сеть в SIMD-регистрах для коротких участков (до 64 элементов int / float) —
+// листовое ядро для сортировок слиянием и быстрой сортировки вместо вставок.
+// Регистр из W дорожек сортируется внутри себя (перестановки + min/max + blend), отсортированные
+// регистры сливаются битонным слиянием: сравнение с развёрнутым соседом, затем полуочистители
+// между регистрами и очистка внутри регистра. Ветвлений по данным нет.
+//   * AVX2: W = 8 (__m256i / __m256), нужен -mavx2 (или -march=native);
+//   * SSE4.1: W = 4 (__m128i / __m128), -msse4.1;
+//   * SSE2 (любой x86-64 без флагов): W = 4, min/max int32 и blend заменены сравнением
+//     и выбором по маске (and / andnot / or) — медленнее SSE4.1, но без ветвлений;
+//   * без SIMD — сортировка вставками из kernels.h (kBitonicLanes == 1).
+// Для float предполагается отсутствие NaN (min/max не упорядочивают NaN).
+
+#include <cstddef>
+#include <limits>
+
+#include "kernels.h"
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+namespace kernels {
+
+// Наибольший участок, который сортирует сеть
+constexpr std::size_t kBitonicMax = 64;
+
+namespace simd {
+
+#if defined(__AVX2__)
+
+// Шаг сравнения-обмена внутри регистра: w — партнёр каждой дорожки, в дорожки с битом MASK идёт max
+template <int MASK>
+inline __m256i cmpx(__m256i v, __m256i w) {
+    return _mm256_blend_epi32(_mm256_min_epi32(v, w), _mm256_max_epi32(v, w), MASK);
+}
+template <int MASK>
+inline __m256 cmpx(__m256 v, __m256 w) {
+    return _mm256_blend_ps(_mm256_min_ps(v, w), _mm256_max_ps(v, w), MASK);
+}
+
+// Партнёры на расстоянии 1, 2, 4 и разворот порядка дорожек
+inline __m256i swap1(__m256i v) { return _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)); }
+inline __m256i swap2(__m256i v) { return _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)); }
+inline __m256i swap4(__m256i v) { return _mm256_permute2x128_si256(v, v, 0x01); }
+inline __m256i reverse(__m256i v) { return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0)); }
+inline __m256 swap1(__m256 v) { return _mm256_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1)); }
+inline __m256 swap2(__m256 v) { return _mm256_permute_ps(v, _MM_SHUFFLE(1, 0, 3, 2)); }
+inline __m256 swap4(__m256 v) { return _mm256_permute2f128_ps(v, v, 0x01); }
+inline __m256 reverse(__m256 v) { return _mm256_permutevar8x32_ps(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0)); }
+
+// Битонная последовательность в регистре -> по возрастанию (шаги 4, 2, 1)
+template <class V>
+inline V cleanReg(V v) {
+    v = cmpx<0xF0>(v, swap4(v));
+    v = cmpx<0xCC>(v, swap2(v));
+    return cmpx<0xAA>(v, swap1(v));
+}
+
+// Полная сортировка 8 дорожек: блоки 2 и 4 сортируются в разные стороны, затем очистка
+template <class V>
+inline V sortReg(V v) {
+    v = cmpx<0x66>(v, swap1(v));
+    v = cmpx<0x3C>(v, swap2(v));
+    v = cmpx<0x5A>(v, swap1(v));
+    return cleanReg(v);
+}
+
+template <class T> struct Reg;
+template <> struct Reg<int> {
+    using type = __m256i;
+    static constexpr int W = 8;
+    static type load(const int* p) { return _mm256_loadu_si256((const __m256i*)p); }
+    static void store(int* p, type v) { _mm256_storeu_si256((__m256i*)p, v); }
+    static type min(type a, type b) { return _mm256_min_epi32(a, b); }
+    static type max(type a, type b) { return _mm256_max_epi32(a, b); }
+};
+template <> struct Reg<float> {
+    using type = __m256;
+    static constexpr int W = 8;
+    static type load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, type v) { _mm256_storeu_ps(p, v); }
+    static type min(type a, type b) { return _mm256_min_ps(a, b); }
+    static type max(type a, type b) { return _mm256_max_ps(a, b); }
+};
+#define KERNELS_HAVE_BITONIC_SIMD 1
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+#if defined(__SSE4_1__)
+inline __m128i min32(__m128i a, __m128i b) { return _mm_min_epi32(a, b); }
+inline __m128i max32(__m128i a, __m128i b) { return _mm_max_epi32(a, b); }
+
+template <int MASK>
+inline __m128i cmpx(__m128i v, __m128i w) {
+    // blend_epi16: по 2 бита маски на 32-битную дорожку
+    constexpr int M16 = ((MASK & 1) ? 0x03 : 0) | ((MASK & 2) ? 0x0C : 0) | ((MASK & 4) ? 0x30 : 0) | ((MASK & 8) ? 0xC0 : 0);
+    return _mm_blend_epi16(min32(v, w), max32(v, w), M16);
+}
+template <int MASK>
+inline __m128 cmpx(__m128 v, __m128 w) {
+    return _mm_blend_ps(_mm_min_ps(v, w), _mm_max_ps(v, w), MASK);
+}
+#else
+// SSE2: min/max int32 через сравнение, blend — выбор по маске дорожек
+inline __m128i select(__m128i m, __m128i a, __m128i b) { // m ? a : b по дорожкам
+    return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+}
+inline __m128i min32(__m128i a, __m128i b) { return select(_mm_cmpgt_epi32(a, b), b, a); }
+inline __m128i max32(__m128i a, __m128i b) { return select(_mm_cmpgt_epi32(a, b), a, b); }
+
+// Дорожка i — все единицы, если в MASK установлен бит i
+template <int MASK>
+inline __m128i laneMask() {
+    return _mm_setr_epi32((MASK & 1) ? -1 : 0, (MASK & 2) ? -1 : 0, (MASK & 4) ? -1 : 0, (MASK & 8) ? -1 : 0);
+}
+
+template <int MASK>
+inline __m128i cmpx(__m128i v, __m128i w) {
+    return select(laneMask<MASK>(), max32(v, w), min32(v, w));
+}
+template <int MASK>
+inline __m128 cmpx(__m128 v, __m128 w) {
+    const __m128 m = _mm_castsi128_ps(laneMask<MASK>());
+    return _mm_or_ps(_mm_and_ps(m, _mm_max_ps(v, w)), _mm_andnot_ps(m, _mm_min_ps(v, w)));
+}
+#endif
+
+inline __m128i swap1(__m128i v) { return _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)); }
+inline __m128i swap2(__m128i v) { return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)); }
+inline __m128i reverse(__m128i v) { return _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3)); }
+inline __m128 swap1(__m128 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)); }
+inline __m128 swap2(__m128 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)); }
+inline __m128 reverse(__m128 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 1, 2, 3)); }
+
+// Битонная последовательность в регистре -> по возрастанию (шаги 2, 1)
+template <class V>
+inline V cleanReg(V v) {
+    v = cmpx<0xC>(v, swap2(v));
+    return cmpx<0xA>(v, swap1(v));
+}
+
+template <class V>
+inline V sortReg(V v) {
+    v = cmpx<0x6>(v, swap1(v));
+    return cleanReg(v);
+}
+
+template <class T> struct Reg;
+template <> struct Reg<int> {
+    using type = __m128i;
+    static constexpr int W = 4;
+    static type load(const int* p) { return _mm_loadu_si128((const __m128i*)p); }
+    static void store(int* p, type v) { _mm_storeu_si128((__m128i*)p, v); }
+    static type min(type a, type b) { return min32(a, b); }
+    static type max(type a, type b) { return max32(a, b); }
+};
+template <> struct Reg<float> {
+    using type = __m128;
+    static constexpr int W = 4;
+    static type load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, type v) { _mm_storeu_ps(p, v); }
+    static type min(type a, type b) { return _mm_min_ps(a, b); }
+    static type max(type a, type b) { return _mm_max_ps(a, b); }
+};
+#define KERNELS_HAVE_BITONIC_SIMD 1
+
+#endif
+
+#ifdef KERNELS_HAVE_BITONIC_SIMD
+
+// Слияние двух отсортированных регистров: a получает младшие W элементов, b — старшие
+template <class T>
+inline void mergeRegs(typename Reg<T>::type& a, typename Reg<T>::type& b) {
+    using R = Reg<T>;
+    typename R::type rb = reverse(b); // a по возрастанию + b по убыванию = битонная последовательность
+    typename R::type lo = R::min(a, rb);
+    typename R::type hi = R::max(a, rb);
+    a = cleanReg(lo);
+    b = cleanReg(hi);
+}
+
+// Сортировка m регистров (m — степень двойки) как одной последовательности из m * W элементов
+template <class T>
+inline void sortRegs(typename Reg<T>::type* v, int m) {
+    using R = Reg<T>;
+    for (int i = 0; i < m; i++) v[i] = sortReg(v[i]);
+    for (int s = 2; s <= m; s *= 2) {             // Сливаем пары отсортированных групп по s/2 регистров
+        for (int g = 0; g < m; g += s) {
+            typename R::type* q = v + g;
+            for (int i = 0; i < s / 2; i++) {     // Сравнение с зеркальным элементом второй половины
+                typename R::type rb = reverse(q[s - 1 - i]);
+                typename R::type lo = R::min(q[i], rb);
+                q[s - 1 - i] = reverse(R::max(q[i], rb));
+                q[i] = lo;
+            }
+            for (int d = s / 4; d >= 1; d /= 2)   // Полуочистители между регистрами
+                for (int i = 0; i < s; i++)
+                    if ((i & d) == 0) {
+                        typename R::type lo = R::min(q[i], q[i + d]);
+                        q[i + d] = R::max(q[i], q[i + d]);
+                        q[i] = lo;
+                    }
+            for (int i = 0; i < s; i++) q[i] = cleanReg(q[i]);
+        }
+    }
+}
+
+#endif
+
+} // namespace simd
+
+// Дорожек int / float в регистре сети (1 — сети нет, сортировка вставками)
+#ifdef KERNELS_HAVE_BITONIC_SIMD
+constexpr int kBitonicLanes = simd::Reg<int>::W;
+#else
+constexpr int kBitonicLanes = 1;
+#endif
+
+// Набор инструкций, с которым собрана сеть, — для отчётов
+#if defined(__AVX2__)
+constexpr const char* kBitonicIsa = "AVX2";
+#elif defined(__SSE4_1__)
+constexpr const char* kBitonicIsa = "SSE4.1";
+#elif defined(KERNELS_HAVE_BITONIC_SIMD)
+constexpr const char* kBitonicIsa = "SSE2";
+#else
+constexpr const char* kBitonicIsa = "нет SIMD";
+#endif
+
+// Заполнитель хвоста последнего регистра: не меньше любого значения типа
+// (для float — +inf, а не FLT_MAX, иначе +inf из данных уходил бы за границу участка)
+template <class T>
+constexpr T bitonicPad() {
+    return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+}
+
+// Сортировка участка a[0, n) по возрастанию; n <= kBitonicMax — сетью в регистрах,
+// хвост последнего регистра дополняется bitonicPad. Длиннее — вставками
+template <class T>
+void bitonicSortSmall(T* a, std::size_t n) {
+#ifdef KERNELS_HAVE_BITONIC_SIMD
+    using R = simd::Reg<T>;
+    constexpr int W = R::W;
+    constexpr int kMaxRegs = (int)(kBitonicMax / W);
+    if (n <= 1) return;
+    if (n > kBitonicMax) {
+        insertionSortSeq(a, 0, n);
+        return;
+    }
+    int regs = 1; // Число регистров — степень двойки
+    while ((std::size_t)regs * W < n) regs *= 2;
+    alignas(64) T buf[kBitonicMax];
+    std::size_t full = n / W; // Регистры без хвоста читаются прямо из массива
+    for (std::size_t k = n; k < (std::size_t)regs * W; k++) buf[k] = bitonicPad<T>();
+    for (std::size_t k = full * W; k < n; k++) buf[k] = a[k];
+    typename R::type v[kMaxRegs];
+    for (int i = 0; i < regs; i++)
+        v[i] = (std::size_t)i < full ? R::load(a + (std::size_t)i * W) : R::load(buf + (std::size_t)i * W);
+    simd::sortRegs<T>(v, regs);
+    for (int i = 0; i < regs; i++) {
+        if ((std::size_t)(i + 1) * W <= n) R::store(a + (std::size_t)i * W, v[i]);
+        else {
+            R::store(buf + (std::size_t)i * W, v[i]);
+            for (std::size_t k = (std::size_t)i * W; k < n; k++) a[k] = buf[k];
+        }
+    }
+#else
+    insertionSortSeq(a, 0, n);
+#endif
+}
+
+// Листовое ядро сортировок: участок [L, R) сетью, если он не длиннее kBitonicMax
+template <class T>
+void sortLeaf(T* a, std::size_t L, std::size_t R) {
+    if (R - L <= kBitonicMax) bitonicSortSmall(a + L, R - L);
+    else insertionSortSeq(a, L, R);
+}
+
+} // namespace kernels
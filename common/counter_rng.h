@@ -0,0 +1,55 @@
+#pragma once // Защита от многократного включения файла
+
+// Счётчиковый генератор случайных чисел (counter-based, SplitMix64).
+// Значение элемента i зависит только от (seed, i), поэтому любой поток может сразу
+// "перемотать" генератор к своему участку: заполнение параллелится и векторизуется,
+// а результат побитово одинаков при любом числе потоков.
+
+#include <cstdint>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Перемешивание SplitMix64: биективная функция 64 -> 64 бит с хорошей лавинностью
+inline std::uint64_t counterMix64(std::uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// 64 случайных бита для элемента i последовательности seed
+inline std::uint64_t counterRandom(std::uint64_t seed, std::uint64_t i) {
+    return counterMix64(counterMix64(seed) ^ (i * 0xD1B54A32D192ED03ull));
+}
+
+// Целое в [lo, hi] (умножение вместо %, без заметного смещения для диапазонов до 2^32)
+inline int counterUniformInt(std::uint64_t seed, std::uint64_t i, int lo, int hi) {
+    std::uint64_t range = (std::uint64_t)((std::int64_t)hi - (std::int64_t)lo) + 1;
+    std::uint64_t r = counterRandom(seed, i) >> 32;
+    return (int)((std::int64_t)lo + (std::int64_t)((r * range) >> 32));
+}
+
+// Вещественное в [0, 1) с 53 значащими битами
+inline double counterUniform01(std::uint64_t seed, std::uint64_t i) {
+    return (double)(counterRandom(seed, i) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Параллельное заполнение a[i] = counterUniformInt(seed, i, lo, hi)
+inline void counterFillInt(int* a, long long n, int lo, int hi, std::uint64_t seed) {
+#ifdef _OPENMP
+#pragma omp parallel for simd schedule(static)
+#endif
+    for (long long i = 0; i < n; i++)
+        a[i] = counterUniformInt(seed, (std::uint64_t)i, lo, hi);
+}
+
+// Параллельное заполнение a[i] = lo + (hi - lo) * U[0, 1)
+inline void counterFillDouble(double* a, long long n, double lo, double hi, std::uint64_t seed) {
+#ifdef _OPENMP
+#pragma omp parallel for simd schedule(static)
+#endif
+    for (long long i = 0; i < n; i++)
+        a[i] = lo + (hi - lo) * counterUniform01(seed, (std::uint64_t)i);
+}
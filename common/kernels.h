@@ -0,0 +1,202 @@
+#pragma once // Защита от многократного включения файла
+
+// Header-only библиотека базовых ядер (редукции и простые сортировки), общая для всех задач.
+// Все функции — шаблоны по типу элемента (int, long long, float, double, ...) и типу накопителя.
+// На этапе компиляции выбираются:
+//   * самый широкий безопасный накопитель: целые -> 64 бита, float -> double;
+//   * число SIMD-дорожек по доступному набору инструкций (SSE2 / AVX2 / AVX-512),
+//     под которое разворачиваются циклы с независимыми частичными результатами.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace kernels {
+
+// Накопитель по умолчанию: знаковые целые -> int64, беззнаковые -> uint64, вещественные -> double
+template <class T, class Enable = void>
+struct Accumulator { using type = T; };
+template <class T>
+struct Accumulator<T, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type> {
+    using type = std::int64_t;
+};
+template <class T>
+struct Accumulator<T, typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type> {
+    using type = std::uint64_t;
+};
+template <>
+struct Accumulator<float> { using type = double; };
+template <class T>
+using accumulator_t = typename Accumulator<T>::type;
+
+// Ширина векторного регистра в байтах для текущей сборки
+#if defined(__AVX512F__)
+constexpr std::size_t kSimdBytes = 64;
+#elif defined(__AVX2__) || defined(__AVX__)
+constexpr std::size_t kSimdBytes = 32;
+#elif defined(__SSE2__) || defined(_M_X64) || defined(__ARM_NEON)
+constexpr std::size_t kSimdBytes = 16;
+#else
+constexpr std::size_t kSimdBytes = 8;
+#endif
+
+// Сколько элементов типа T помещается в один регистр (не меньше 1)
+template <class T>
+constexpr int simdLanes() { return sizeof(T) >= kSimdBytes ? 1 : (int)(kSimdBytes / sizeof(T)); }
+
+// ---------- Редукции ----------
+
+// Сумма с W независимыми частичными суммами — компилятор разносит их по дорожкам SIMD
+template <class T, class Acc = accumulator_t<T>>
+Acc sumSequential(const T* a, std::size_t n) {
+    constexpr int W = simdLanes<Acc>();
+    Acc part[W] = {};
+    const std::size_t body = n - n % W; // Хвост короче W: счётчик циклов явно ограничен
+    for (std::size_t i = 0; i < body; i += W)
+        for (int k = 0; k < W; k++) part[k] += (Acc)a[i + k];
+    Acc s = 0;
+    for (int k = 0; k < W; k++) s += part[k];
+    for (std::size_t i = body; i < n; i++) s += (Acc)a[i];
+    return s;
+}
+
+template <class T, class Acc = accumulator_t<T>>
+double averageSequential(const T* a, std::size_t n) {
+    return n ? (double)sumSequential<T, Acc>(a, n) / (double)n : 0.0;
+}
+
+// min и max за один проход, без ветвлений (std::min/max -> vpminsd / minps)
+template <class T>
+void minmaxSequential(const T* a, std::size_t n, T& outMin, T& outMax) {
+    constexpr int W = simdLanes<T>();
+    T mn[W], mx[W];
+    for (int k = 0; k < W; k++) {
+        mn[k] = std::numeric_limits<T>::max();
+        mx[k] = std::numeric_limits<T>::lowest();
+    }
+    std::size_t i = 0;
+    for (; i + W <= n; i += W)
+        for (int k = 0; k < W; k++) {
+            mn[k] = std::min(mn[k], a[i + k]);
+            mx[k] = std::max(mx[k], a[i + k]);
+        }
+    for (; i < n; i++) {
+        mn[0] = std::min(mn[0], a[i]);
+        mx[0] = std::max(mx[0], a[i]);
+    }
+    for (int k = 1; k < W; k++) {
+        mn[0] = std::min(mn[0], mn[k]);
+        mx[0] = std::max(mx[0], mx[k]);
+    }
+    outMin = mn[0];
+    outMax = mx[0];
+}
+
+// Непрерывный кусок [L, R) потока tid из nt (то же разбиение, что schedule(static))
+inline void staticChunk(std::size_t n, int tid, int nt, std::size_t& L, std::size_t& R) {
+    L = n * (std::size_t)tid / (std::size_t)nt;
+    R = n * (std::size_t)(tid + 1) / (std::size_t)nt;
+}
+
+// Параллельная сумма: каждый поток считает свой кусок векторным ядром, потоки складываются reduction
+template <class T, class Acc = accumulator_t<T>>
+Acc sumParallel(const T* a, std::size_t n) {
+    Acc s = 0;
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:s)
+    {
+        std::size_t L, R;
+        staticChunk(n, omp_get_thread_num(), omp_get_num_threads(), L, R);
+        s += sumSequential<T, Acc>(a + L, R - L);
+    }
+#else
+    s = sumSequential<T, Acc>(a, n);
+#endif
+    return s;
+}
+
+template <class T, class Acc = accumulator_t<T>>
+double averageParallel(const T* a, std::size_t n) {
+    return n ? (double)sumParallel<T, Acc>(a, n) / (double)n : 0.0;
+}
+
+template <class T>
+void minmaxParallel(const T* a, std::size_t n, T& outMin, T& outMax) {
+#ifdef _OPENMP
+    T mn = std::numeric_limits<T>::max();
+    T mx = std::numeric_limits<T>::lowest();
+#pragma omp parallel reduction(min:mn) reduction(max:mx)
+    {
+        std::size_t L, R;
+        staticChunk(n, omp_get_thread_num(), omp_get_num_threads(), L, R);
+        T lmn, lmx;
+        minmaxSequential(a + L, R - L, lmn, lmx);
+        mn = std::min(mn, lmn);
+        mx = std::max(mx, lmx);
+    }
+    outMin = mn;
+    outMax = mx;
+#else
+    minmaxSequential(a, n, outMin, outMax);
+#endif
+}
+
+// ---------- Сортировки ----------
+
+// Пузырёк с ранним выходом, если за проход не было обменов
+template <class T>
+void bubbleSortSeq(T* a, std::size_t n) {
+    for (std::size_t pass = 0; pass + 1 < n; pass++) {
+        bool swapped = false;
+        for (std::size_t j = 0; j + 1 < n - pass; j++) {
+            if (a[j + 1] < a[j]) {
+                std::swap(a[j], a[j + 1]);
+                swapped = true;
+            }
+        }
+        if (!swapped) break;
+    }
+}
+
+// Выбор: минимум хвоста ставится на позицию i
+template <class T>
+void selectionSortSeq(T* a, std::size_t n) {
+    for (std::size_t i = 0; i + 1 < n; i++) {
+        std::size_t minIdx = i;
+        for (std::size_t j = i + 1; j < n; j++)
+            if (a[j] < a[minIdx]) minIdx = j;
+        if (minIdx != i) std::swap(a[i], a[minIdx]);
+    }
+}
+
+// Вставки на участке [L, R)
+template <class T>
+void insertionSortSeq(T* a, std::size_t L, std::size_t R) {
+    for (std::size_t i = L + 1; i < R; i++) {
+        T key = a[i];
+        std::size_t j = i;
+        while (j > L && key < a[j - 1]) {
+            a[j] = a[j - 1];
+            j--;
+        }
+        a[j] = key;
+    }
+}
+
+// Устойчивое слияние src[L, M) и src[M, R) в dst[L, R) (без копирования назад)
+template <class T>
+void mergeRanges(const T* src, T* dst, std::size_t L, std::size_t M, std::size_t R) {
+    std::size_t i = L, j = M, k = L;
+    while (i < M && j < R) dst[k++] = (src[j] < src[i]) ? src[j++] : src[i++];
+    while (i < M) dst[k++] = src[i++];
+    while (j < R) dst[k++] = src[j++];
+}
+
+} // namespace kernels
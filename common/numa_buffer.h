@@ -0,0 +1,144 @@
+#pragma once // Защита от многократного включения файла
+
+// Буфер для больших массивов с параллельным первым касанием (first-touch).
+// Linux размещает страницу на NUMA-узле потока, который первым в неё записал.
+// Если массив инициализирует один поток, все страницы оказываются на одном сокете,
+// и параллельные редукции упираются в межсокетную шину. Здесь страницы касаются
+// потоки с тем же schedule(static), что и в вычислительных циклах, — каждый поток
+// потом читает память своего узла. Дополнительно можно попросить 2 МБ huge pages (THP).
+
+#include <cstddef>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Выравнивание под 2 МБ, чтобы THP могли покрыть буфер целиком
+constexpr std::size_t kHugePageBytes = (std::size_t)2 << 20;
+
+template <class T>
+class NumaBuffer {
+public:
+    NumaBuffer() = default;
+
+    // n элементов, инициализированных T() параллельно (first-touch);
+    // hugePages — попросить у ядра прозрачные huge pages (madvise MADV_HUGEPAGE)
+    explicit NumaBuffer(std::size_t n, bool hugePages = false) : n_(n) {
+        std::size_t bytes = (n * sizeof(T) + kHugePageBytes - 1) / kHugePageBytes * kHugePageBytes;
+        if (bytes == 0) return;
+#if defined(_MSC_VER)
+        data_ = (T*)_aligned_malloc(bytes, kHugePageBytes);
+#else
+        void* p = nullptr;
+        if (posix_memalign(&p, kHugePageBytes, bytes) != 0) p = nullptr;
+        data_ = (T*)p;
+#endif
+        if (!data_) { n_ = 0; return; }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (hugePages) hugePages_ = (madvise(data_, bytes, MADV_HUGEPAGE) == 0);
+#else
+        (void)hugePages;
+#endif
+        T* d = data_;
+        long long count = (long long)n;
+        // То же статическое разбиение, что и в циклах редукции: страницы попадают на узел "своего" потока
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (long long i = 0; i < count; i++) d[i] = T();
+    }
+
+    ~NumaBuffer() { release(); }
+
+    NumaBuffer(const NumaBuffer&) = delete;
+    NumaBuffer& operator=(const NumaBuffer&) = delete;
+
+    NumaBuffer(NumaBuffer&& o) noexcept { swap(o); }
+    NumaBuffer& operator=(NumaBuffer&& o) noexcept {
+        if (this != &o) {
+            release();
+            swap(o);
+        }
+        return *this;
+    }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    std::size_t size() const { return n_; }
+    T& operator[](std::size_t i) { return data_[i]; }
+    const T& operator[](std::size_t i) const { return data_[i]; }
+    bool hugePages() const { return hugePages_; } // madvise(MADV_HUGEPAGE) принят ядром
+
+private:
+    void release() {
+#if defined(_MSC_VER)
+        _aligned_free(data_);
+#else
+        std::free(data_);
+#endif
+        data_ = nullptr;
+        n_ = 0;
+        hugePages_ = false;
+    }
+
+    void swap(NumaBuffer& o) {
+        std::swap(data_, o.data_);
+        std::swap(n_, o.n_);
+        std::swap(hugePages_, o.hugePages_);
+    }
+
+    T* data_ = nullptr;
+    std::size_t n_ = 0;
+    bool hugePages_ = false;
+};
+
+// Где физически лежат страницы буфера: выборка до samples страниц через move_pages(2)
+// (с nodes = NULL системный вызов только сообщает узел). Пример: "node0 50%, node1 50%"
+inline std::string numaPlacement(const void* p, std::size_t bytes, int samples = 256) {
+#if defined(__linux__) && defined(SYS_move_pages)
+    long pageSize = sysconf(_SC_PAGESIZE);
+    std::size_t pages = (bytes + pageSize - 1) / pageSize;
+    if (pages == 0) return "empty";
+    std::size_t count = pages < (std::size_t)samples ? pages : (std::size_t)samples;
+    std::vector<void*> addrs(count);
+    std::vector<int> status(count, -1);
+    for (std::size_t k = 0; k < count; k++) {
+        std::size_t page = k * pages / count;
+        addrs[k] = (void*)((const char*)p + page * pageSize);
+    }
+    if (syscall(SYS_move_pages, 0, (unsigned long)count, addrs.data(), nullptr, status.data(), 0) != 0)
+        return "n/a";
+    std::map<int, int> perNode;
+    for (int s : status) perNode[s]++;
+    std::string out;
+    for (const auto& kv : perNode) {
+        if (!out.empty()) out += ", ";
+        out += kv.first >= 0 ? "node" + std::to_string(kv.first) : "unmapped";
+        out += " " + std::to_string(kv.second * 100 / (int)count) + "%";
+    }
+    return out;
+#else
+    (void)p; (void)bytes; (void)samples;
+    return "n/a";
+#endif
+}
+
+// Режим huge pages из окружения: BENCH_HUGEPAGES=1
+inline bool numaHugePagesFromEnv() {
+    const char* s = std::getenv("BENCH_HUGEPAGES");
+    return s && s[0] == '1';
+}
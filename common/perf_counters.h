@@ -0,0 +1,279 @@
+#pragma once // Защита от многократного включения файла
+
+// Аппаратные счётчики производительности вокруг замеряемых участков (Linux, perf_event_open).
+// Время само по себе не объясняет, почему ветвистый min/max или чёт-нечётная сортировка ведут себя
+// именно так; счётчики показывают IPC, промахи L1d/LLC/dTLB и ошибки предсказания переходов.
+//   * PerfCounts  — значения одного участка (сумма по потокам) и производные метрики;
+//   * PerfSession — счётчики, открытые для каждого потока OpenMP; start/stop вокруг участка
+//     (одна сессия на серию повторов, значения накапливаются), read — итог;
+//   * PerfScope   — RAII для разового участка: открывает и запускает счётчики в конструкторе,
+//     останавливает и записывает результат в деструкторе.
+// Считается только пользовательский режим (exclude_kernel) — так разрешено без root при
+// perf_event_paranoid <= 2. Недоступное событие (виртуальная машина без PMU, paranoid = 3, seccomp
+// в контейнере, не Linux) просто не выводится, причина печатается один раз в stderr.
+// BENCH_PERF=0 отключает счётчики совсем.
+// Потоки: счётчики открываются внутри omp parallel на каждом потоке пула. OpenMP переиспользует
+// эти потоки в следующих регионах с тем же или меньшим числом потоков, поэтому их работа попадает в сумму.
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define PERF_COUNTERS_LINUX 1
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+enum PerfEvent {
+    kPerfCycles,
+    kPerfInstructions,
+    kPerfL1dMisses,     // Промахи чтения L1 данных
+    kPerfLlcMisses,     // Промахи последнего уровня кэша (обращения в память)
+    kPerfBranchMisses,  // Неверно предсказанные переходы
+    kPerfDtlbMisses,    // Промахи чтения dTLB
+    kPerfPageFaults,    // Программное событие: первое касание страниц внутри участка
+    kPerfEventCount
+};
+
+// Имя события для CSV/JSON
+inline const char* perfEventName(int e) {
+    static const char* names[kPerfEventCount] = {
+        "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses", "dtlb_misses", "page_faults"};
+    return names[e];
+}
+
+struct PerfCounts {
+    double value[kPerfEventCount] = {};
+    bool valid[kPerfEventCount] = {};  // Событие удалось открыть хотя бы на одном потоке
+
+    bool has(PerfEvent e) const { return valid[e]; }
+    bool any() const {
+        for (bool v : valid) if (v) return true;
+        return false;
+    }
+
+    // Инструкций за такт (0 — cycles/instructions недоступны)
+    double ipc() const {
+        return has(kPerfCycles) && has(kPerfInstructions) && value[kPerfCycles] > 0
+            ? value[kPerfInstructions] / value[kPerfCycles] : 0.0;
+    }
+    // Событий на 1000 инструкций (MPKI для промахов)
+    double perKiloInstr(PerfEvent e) const {
+        return has(e) && has(kPerfInstructions) && value[kPerfInstructions] > 0
+            ? 1000.0 * value[e] / value[kPerfInstructions] : 0.0;
+    }
+
+    // Пересчёт накопленного за reps запусков в значения на один запуск
+    void divide(double reps) {
+        if (reps <= 0) return;
+        for (double& v : value) v /= reps;
+    }
+};
+
+// Строка для консоли: "IPC 1.85, на 1000 инстр.: L1d 12.3, LLC 0.41, br 2.10, dTLB 0.05; pf 12".
+// Пустая, если ни одно событие недоступно
+inline std::string perfBrief(const PerfCounts& c) {
+    std::string s;
+    char buf[64];
+    if (c.ipc() > 0) {
+        std::snprintf(buf, sizeof(buf), "IPC %.2f", c.ipc());
+        s += buf;
+    }
+    if (c.has(kPerfInstructions) && c.value[kPerfInstructions] > 0) {
+        const PerfEvent ev[] = {kPerfL1dMisses, kPerfLlcMisses, kPerfBranchMisses, kPerfDtlbMisses};
+        const char* label[] = {"L1d", "LLC", "br", "dTLB"};
+        std::string miss;
+        for (int i = 0; i < 4; i++) {
+            if (!c.has(ev[i])) continue;
+            std::snprintf(buf, sizeof(buf), "%s%s %.3g", miss.empty() ? "" : ", ", label[i], c.perKiloInstr(ev[i]));
+            miss += buf;
+        }
+        if (!miss.empty()) s += (s.empty() ? "" : ", ") + std::string("на 1000 инстр.: ") + miss;
+    }
+    if (c.has(kPerfPageFaults)) {
+        std::snprintf(buf, sizeof(buf), "%spf %.0f", s.empty() ? "" : "; ", c.value[kPerfPageFaults]);
+        s += buf;
+    }
+    return s;
+}
+
+// Счётчики выключены через окружение (BENCH_PERF=0)
+inline bool perfEnabledFromEnv() {
+    const char* s = std::getenv("BENCH_PERF");
+    return !(s && std::atoi(s) == 0);
+}
+
+namespace perf_detail {
+
+#ifdef PERF_COUNTERS_LINUX
+struct EventSpec { std::uint32_t type; std::uint64_t config; };
+
+inline std::uint64_t cacheConfig(std::uint64_t cache, std::uint64_t op, std::uint64_t result) {
+    return cache | (op << 8) | (result << 16);
+}
+
+inline EventSpec eventSpec(int e) {
+    switch (e) {
+    case kPerfCycles:       return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES};
+    case kPerfInstructions: return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS};
+    case kPerfL1dMisses:    return {PERF_TYPE_HW_CACHE, cacheConfig(PERF_COUNT_HW_CACHE_L1D,
+                                    PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)};
+    case kPerfLlcMisses:    return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES};
+    case kPerfBranchMisses: return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES};
+    case kPerfDtlbMisses:   return {PERF_TYPE_HW_CACHE, cacheConfig(PERF_COUNT_HW_CACHE_DTLB,
+                                    PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)};
+    default:                return {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS};
+    }
+}
+
+// Счётчик события e для вызывающего потока, созданный выключенным. -1 и errno — не удалось
+inline int openEvent(int e) {
+    const EventSpec spec = eventSpec(e);
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // Событий больше, чем аппаратных счётчиков, — ядро делит их по времени; поправка по этим полям
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+}
+#endif
+
+// Один раз на процесс сообщает, какие события недоступны и почему
+inline void reportUnavailable(const PerfCounts& opened, int err) {
+    static bool reported = false;
+    if (reported) return;
+    std::string missing;
+    for (int e = 0; e < kPerfEventCount; e++)
+        if (!opened.valid[e]) missing += std::string(missing.empty() ? "" : ", ") + perfEventName(e);
+    if (missing.empty()) return;
+    reported = true;
+#ifdef PERF_COUNTERS_LINUX
+    std::fprintf(stderr, "perf: недоступны %s (%s); см. /proc/sys/kernel/perf_event_paranoid\n",
+        missing.c_str(), err ? std::strerror(err) : "?");
+#else
+    (void)err;
+    std::fprintf(stderr, "perf: счётчики поддерживаются только в Linux\n");
+#endif
+}
+
+} // namespace perf_detail
+
+class PerfSession {
+public:
+    // Открывает счётчики на каждом потоке пула OpenMP (или только на текущем без OpenMP)
+    PerfSession() {
+        if (!perfEnabledFromEnv()) return;
+#ifdef PERF_COUNTERS_LINUX
+        threads_ = 1;
+#ifdef _OPENMP
+        threads_ = omp_get_max_threads();
+#endif
+        fds_.assign((size_t)threads_ * kPerfEventCount, -1);
+        int lastErr = 0;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threads_)
+#endif
+        {
+            int t = 0;
+#ifdef _OPENMP
+            t = omp_get_thread_num();
+#endif
+            for (int e = 0; e < kPerfEventCount; e++) {
+                int fd = perf_detail::openEvent(e);
+                fds_[(size_t)t * kPerfEventCount + e] = fd;
+                if (fd < 0) {
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+                    lastErr = errno;
+                }
+            }
+        }
+        for (size_t i = 0; i < fds_.size(); i++)
+            if (fds_[i] >= 0) opened_.valid[i % kPerfEventCount] = true;
+        perf_detail::reportUnavailable(opened_, lastErr);
+#else
+        perf_detail::reportUnavailable(opened_, 0);
+#endif
+    }
+
+    ~PerfSession() {
+#ifdef PERF_COUNTERS_LINUX
+        for (int fd : fds_) if (fd >= 0) close(fd);
+#endif
+    }
+
+    PerfSession(const PerfSession&) = delete;
+    PerfSession& operator=(const PerfSession&) = delete;
+
+    bool active() const { return opened_.any(); }
+
+    // Включить/выключить все счётчики; между start и stop значения накапливаются
+    void start() { control(true); }
+    void stop() { control(false); }
+
+    // Сумма по потокам с поправкой на разделение счётчиков по времени
+    PerfCounts read() const {
+        PerfCounts c;
+#ifdef PERF_COUNTERS_LINUX
+        for (size_t i = 0; i < fds_.size(); i++) {
+            if (fds_[i] < 0) continue;
+            std::uint64_t buf[3] = {}; // value, time_enabled, time_running
+            if (::read(fds_[i], buf, sizeof(buf)) != (ssize_t)sizeof(buf)) continue;
+            const int e = (int)(i % kPerfEventCount);
+            double v = (double)buf[0];
+            if (buf[2] > 0 && buf[2] < buf[1]) v *= (double)buf[1] / (double)buf[2];
+            c.value[e] += v;
+            c.valid[e] = true;
+        }
+#endif
+        return c;
+    }
+
+private:
+    void control(bool on) {
+#ifdef PERF_COUNTERS_LINUX
+        const unsigned long req = on ? PERF_EVENT_IOC_ENABLE : PERF_EVENT_IOC_DISABLE;
+        for (int fd : fds_) if (fd >= 0) ioctl(fd, req, 0);
+#else
+        (void)on;
+#endif
+    }
+
+    int threads_ = 0;
+    std::vector<int> fds_;  // [поток * kPerfEventCount + событие], -1 — не открыт
+    PerfCounts opened_;     // Какие события открылись хотя бы на одном потоке
+};
+
+// RAII-замер участка: { PerfCounts pc; { PerfScope s(pc); kernel(); } cout << perfBrief(pc); }
+class PerfScope {
+public:
+    explicit PerfScope(PerfCounts& out) : out_(out) { session_.start(); }
+    ~PerfScope() {
+        session_.stop();
+        out_ = session_.read();
+    }
+
+    PerfScope(const PerfScope&) = delete;
+    PerfScope& operator=(const PerfScope&) = delete;
+
+private:
+    PerfCounts& out_;
+    PerfSession session_;
+};
@@ -0,0 +1,196 @@
+#pragma once // Защита от многократного включения файла
+
+// Пропускная способность памяти и модель roofline для всех замеров.
+// Редукции (сумма, среднее, min/max) делают 1 операцию на 4-8 байт, поэтому упираются в память,
+// а не в вычисления: время в мс само по себе не говорит, насколько ядро близко к пределу железа.
+//   * streamSuite — набор STREAM (McCalpin): copy, scale, add, triad по массивам double,
+//     каждый в двух вариантах записи: обычной и потоковой (non-temporal, мимо кэша, без чтения
+//     строки перед записью). Лучший результат — измеренный пик хоста;
+//   * hostPeakBandwidth — этот пик, измеряется один раз на процесс (STREAM_PEAK_GBPS задаёт вручную);
+//   * rooflineAttach / rooflineBrief — для любого замера: байты, ГБ/с, % пика и арифметическая
+//     интенсивность (флоп/байт); те же поля попадают в CSV/JSON BenchReport — точки для графика roofline.
+// Байты считаются по соглашению STREAM: чтение + запись каждого элемента, без дочитывания строки
+// перед обычной записью (write-allocate). Поэтому у обычных записей реальный трафик на 1/3–1/2 больше,
+// и потоковые варианты показывают заметно больше ГБ/с.
+// Размер массивов: STREAM_N элементов (по умолчанию 2^24, 128 МБ на массив — много больше L3).
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "kernels.h"
+#include "numa_buffer.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ROOFLINE_HAVE_NT_STORE 1
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Объём трафика и число операций одного запуска ядра
+struct Traffic {
+    double bytes = 0;  // Прочитано + записано (по соглашению STREAM)
+    double flops = 0;  // Арифметических операций
+
+    double intensity() const { return bytes > 0 ? flops / bytes : 0.0; } // флоп/байт — ось X roofline
+};
+
+// Трафик для n элементов типа T: reads массивов читается, writes — пишется, flopsPerElem операций на элемент
+template <class T>
+Traffic trafficFor(long long n, int reads, int writes, double flopsPerElem) {
+    Traffic t;
+    t.bytes = (double)n * sizeof(T) * (reads + writes);
+    t.flops = (double)n * flopsPerElem;
+    return t;
+}
+
+// Точка roofline в BenchStats: байты и операции попадают в CSV/JSON отчёта
+inline void rooflineAttach(BenchStats& st, const Traffic& t) {
+    st.bytes = t.bytes;
+    st.flops = t.flops;
+}
+
+struct StreamResult {
+    std::string name;
+    Traffic traffic;
+    BenchStats st;
+
+    double gbPerSec() const { return st.gbPerSec(); }
+};
+
+namespace stream_detail {
+
+// dst[i] = s1 * x[i] + s2 * y[i] на куске потока; вырожденные случаи дают copy/scale/add/triad.
+// nonTemporal — запись _mm_stream_pd (строки не читаются в кэш и не вытесняют его)
+template <bool HasY>
+inline void streamKernel(double* dst, const double* x, const double* y, double s1, double s2,
+                         std::size_t n, bool nonTemporal) {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::size_t L = 0, R = n;
+#ifdef _OPENMP
+        kernels::staticChunk(n, omp_get_thread_num(), omp_get_num_threads(), L, R);
+#endif
+        std::size_t i = L;
+#ifdef ROOFLINE_HAVE_NT_STORE
+        if (nonTemporal) {
+            for (; i < R && ((std::size_t)(dst + i) & 15) != 0; i++)  // голова до выравнивания 16 байт
+                dst[i] = s1 * x[i] + (HasY ? s2 * y[i] : 0.0);
+            const __m128d v1 = _mm_set1_pd(s1), v2 = _mm_set1_pd(s2);
+            for (; i + 2 <= R; i += 2) {
+                __m128d v = _mm_mul_pd(v1, _mm_loadu_pd(x + i));
+                if (HasY) v = _mm_add_pd(v, _mm_mul_pd(v2, _mm_loadu_pd(y + i)));
+                _mm_stream_pd(dst + i, v);
+            }
+            _mm_sfence(); // Потоковые записи видны другим потокам только после sfence
+        }
+#else
+        (void)nonTemporal;
+#endif
+        for (; i < R; i++) dst[i] = s1 * x[i] + (HasY ? s2 * y[i] : 0.0);
+    }
+}
+
+} // namespace stream_detail
+
+// Набор STREAM на массивах из n double: 4 ядра × {обычная запись, потоковая запись}
+inline std::vector<StreamResult> streamSuite(std::size_t n, const BenchConfig& cfg) {
+    // Первое касание тем же разбиением, что и в ядрах: страницы на узле "своего" потока
+    NumaBuffer<double> a(n), b(n), c(n);
+    double* pa = a.data();
+    double* pb = b.data();
+    double* pc = c.data();
+    const long long count = (long long)n;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (long long i = 0; i < count; i++) { pa[i] = 1.0; pb[i] = 2.0; pc[i] = 0.0; }
+    const double s = 3.0;
+
+    std::vector<StreamResult> out;
+    const long long N = count;
+    for (int nt = 0; nt < 2; nt++) {
+        const bool nonTemporal = nt == 1;
+#ifndef ROOFLINE_HAVE_NT_STORE
+        if (nonTemporal) break;
+#endif
+        const std::string suffix = nonTemporal ? "_nt" : "";
+        // copy: c = a (16 байт на элемент, 0 флоп)
+        out.push_back({"copy" + suffix, trafficFor<double>(N, 1, 1, 0),
+            benchRun("stream_copy" + suffix, N, cfg, [&] {
+                stream_detail::streamKernel<false>(pc, pa, nullptr, 1.0, 0.0, n, nonTemporal); })});
+        // scale: b = s * c (16 байт, 1 флоп)
+        out.push_back({"scale" + suffix, trafficFor<double>(N, 1, 1, 1),
+            benchRun("stream_scale" + suffix, N, cfg, [&] {
+                stream_detail::streamKernel<false>(pb, pc, nullptr, s, 0.0, n, nonTemporal); })});
+        // add: c = a + b (24 байта, 1 флоп)
+        out.push_back({"add" + suffix, trafficFor<double>(N, 2, 1, 1),
+            benchRun("stream_add" + suffix, N, cfg, [&] {
+                stream_detail::streamKernel<true>(pc, pa, pb, 1.0, 1.0, n, nonTemporal); })});
+        // triad: a = b + s * c (24 байта, 2 флопа)
+        out.push_back({"triad" + suffix, trafficFor<double>(N, 2, 1, 2),
+            benchRun("stream_triad" + suffix, N, cfg, [&] {
+                stream_detail::streamKernel<true>(pa, pb, pc, 1.0, s, n, nonTemporal); })});
+    }
+    for (StreamResult& r : out) rooflineAttach(r.st, r.traffic);
+    return out;
+}
+
+// Размер массивов STREAM из окружения (STREAM_N), по умолчанию 2^24 double на массив
+inline std::size_t streamSizeFromEnv() {
+    if (const char* s = std::getenv("STREAM_N")) {
+        long long n = std::atoll(s);
+        if (n > 0) return (std::size_t)n;
+    }
+    return (std::size_t)1 << 24;
+}
+
+// Лучший результат набора, ГБ/с
+inline double streamBest(const std::vector<StreamResult>& rs) {
+    double best = 0;
+    for (const StreamResult& r : rs) best = std::max(best, r.gbPerSec());
+    return best;
+}
+
+// Измеренный пик пропускной способности хоста (ГБ/с). Считается один раз на процесс
+// при текущем числе потоков; STREAM_PEAK_GBPS позволяет задать значение и не мерить
+inline double hostPeakBandwidth() {
+    static double peak = [] {
+        if (const char* s = std::getenv("STREAM_PEAK_GBPS")) {
+            double v = std::atof(s);
+            if (v > 0) return v;
+        }
+        BenchConfig cfg = BenchConfig::fromEnv();
+        cfg.reps = std::min(cfg.reps, 5);
+        return streamBest(streamSuite(streamSizeFromEnv(), cfg));
+    }();
+    return peak;
+}
+
+// Одна строка для консоли: "20.0 MB, 12.40 GB/s (61 % пика 20.3), 0.125 флоп/байт"
+inline std::string rooflineBrief(double ns, const Traffic& t, double peakGBps) {
+    const double gbps = ns > 0 ? t.bytes / ns : 0.0; // байт/нс = ГБ/с
+    const bool small = t.bytes < 1e6;                   // десятки КБ не превращаются в "0.0 MB"
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "%.1f %s, %.2f GB/s (%.0f %% пика %.1f), %.3g флоп/байт",
+        small ? t.bytes / 1e3 : t.bytes / 1e6, small ? "KB" : "MB", gbps,
+        peakGBps > 0 ? 100.0 * gbps / peakGBps : 0.0, peakGBps, t.intensity());
+    return buf;
+}
+
+// То же для замера benchRun (байты и операции — из rooflineAttach, время — медиана)
+inline std::string rooflineBrief(const BenchStats& st, double peakGBps) {
+    Traffic t;
+    t.bytes = st.bytes;
+    t.flops = st.flops;
+    return rooflineBrief(st.medianNs, t, peakGBps);
+}
@@ -0,0 +1,166 @@
+#pragma once // Защита от многократного включения файла
+
+// Режим масштабирования: перебор числа потоков (1..число ядер) и размеров по декадам.
+// Сильная масштабируемость: фиксированный N, растёт число потоков -> ускорение,
+// эффективность и доля последовательной части по Карпу–Флэтту.
+// Слабая масштабируемость: N = n0 * p -> время на элемент и эффективность T(1, n0) / T(p, n0*p).
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "roofline.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Ядро для перебора: prepare(n) готовит данные (не замеряется),
+// reset() вызывается перед каждым повтором (может быть пустым), run() — замеряемый код.
+// traffic — байты и операции на один элемент (если заданы, в таблице появляются ГБ/с)
+struct ScalingKernel {
+    std::string name;
+    std::function<void(long long)> prepare;
+    std::function<void()> reset;
+    std::function<void()> run;
+    Traffic traffic;
+};
+
+struct ScalingPoint {
+    std::string mode;        // "strong" или "weak"
+    int threads = 1;
+    long long n = 0;
+    double medianNs = 0;
+    double speedup = 1;      // T(1) / T(p)
+    double efficiency = 1;   // speedup / p
+    double karpFlatt = 0;    // Экспериментальная доля последовательной части
+    double nsPerElem = 0;
+    double gbPerSec = 0;     // Достигнутая пропускная способность (если у ядра задан traffic)
+};
+
+// Число потоков для перебора: 1, 2, 4, ... и обязательно число ядер
+// (верхнюю границу можно задать переменной SCALING_MAX_THREADS)
+inline std::vector<int> scalingThreadCounts() {
+    int maxT = 1;
+#ifdef _OPENMP
+    maxT = omp_get_num_procs();
+#endif
+    if (const char* s = std::getenv("SCALING_MAX_THREADS")) maxT = std::max(1, std::atoi(s));
+    std::vector<int> ts;
+    for (int t = 1; t < maxT; t *= 2) ts.push_back(t);
+    ts.push_back(maxT);
+    return ts;
+}
+
+// Размеры по декадам: from, from*10, ..., to
+inline std::vector<long long> scalingDecades(long long from, long long to) {
+    std::vector<long long> ns;
+    for (long long n = from; n <= to; n *= 10) ns.push_back(n);
+    return ns;
+}
+
+// Метрика Карпа–Флэтта: e = (1/S - 1/p) / (1 - 1/p), для p = 1 не определена
+inline double karpFlattMetric(double speedup, int p) {
+    if (p <= 1 || speedup <= 0) return 0.0;
+    return (1.0 / speedup - 1.0 / p) / (1.0 - 1.0 / p);
+}
+
+inline BenchStats scalingMeasure(ScalingKernel& k, long long n, int threads, BenchReport& report) {
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+#else
+    (void)threads;
+#endif
+    BenchConfig cfg = BenchConfig::fromEnv();
+    BenchStats st = k.reset ? benchRun(k.name, n, cfg, k.reset, k.run) : benchRun(k.name, n, cfg, k.run);
+    Traffic t;
+    t.bytes = k.traffic.bytes * (double)n;
+    t.flops = k.traffic.flops * (double)n;
+    rooflineAttach(st, t);
+    report.add(st);
+    return st;
+}
+
+// Полный перебор для одной функции (kernel). sizes — размеры для сильной масштабируемости,
+// weakPerThread — элементов на поток для слабой (0 — пропустить)
+inline std::vector<ScalingPoint> scalingSweep(ScalingKernel k, const std::vector<long long>& sizes,
+                                              long long weakPerThread, BenchReport& report) {
+    std::vector<ScalingPoint> points;
+    std::vector<int> threads = scalingThreadCounts();
+#ifdef _OPENMP
+    int savedThreads = omp_get_max_threads();
+#endif
+
+    std::printf("\n[Scaling] %s, потоки 1..%d\n", k.name.c_str(), threads.back());
+    std::printf("  %-6s %12s %8s %12s %9s %11s %11s %9s\n",
+        "mode", "N", "threads", "time_ms", "speedup", "efficiency", "karp_flatt", "GB/s");
+
+    for (long long n : sizes) {
+        k.prepare(n);
+        double t1 = 0;
+        for (int p : threads) {
+            BenchStats st = scalingMeasure(k, n, p, report);
+            ScalingPoint pt;
+            pt.mode = "strong";
+            pt.threads = p;
+            pt.n = n;
+            pt.medianNs = st.medianNs;
+            if (p == 1) t1 = st.medianNs;
+            pt.speedup = st.medianNs > 0 ? t1 / st.medianNs : 0.0;
+            pt.efficiency = pt.speedup / p;
+            pt.karpFlatt = karpFlattMetric(pt.speedup, p);
+            pt.nsPerElem = st.medianNs / (double)n;
+            pt.gbPerSec = st.gbPerSec();
+            points.push_back(pt);
+            std::printf("  %-6s %12lld %8d %12.3f %9.2f %11.2f %11.3f %9.2f\n", "strong", n, p,
+                pt.medianNs / 1e6, pt.speedup, pt.efficiency, pt.karpFlatt, pt.gbPerSec);
+        }
+    }
+
+    if (weakPerThread > 0) {
+        double t1 = 0;
+        std::printf("  %-6s %12s %8s %12s %9s %11s %9s\n", "mode", "N", "threads", "time_ms", "ns/elem", "weak_eff", "GB/s");
+        for (int p : threads) {
+            long long n = weakPerThread * p;
+            k.prepare(n);
+            BenchStats st = scalingMeasure(k, n, p, report);
+            ScalingPoint pt;
+            pt.mode = "weak";
+            pt.threads = p;
+            pt.n = n;
+            pt.medianNs = st.medianNs;
+            if (p == 1) t1 = st.medianNs;
+            pt.efficiency = st.medianNs > 0 ? t1 / st.medianNs : 0.0;
+            pt.speedup = pt.efficiency * p; // Масштабированное ускорение
+            pt.nsPerElem = st.medianNs / (double)n;
+            pt.gbPerSec = st.gbPerSec();
+            points.push_back(pt);
+            std::printf("  %-6s %12lld %8d %12.3f %9.3f %11.2f %9.2f\n", "weak", n, p,
+                pt.medianNs / 1e6, pt.nsPerElem, pt.efficiency, pt.gbPerSec);
+        }
+    }
+
+#ifdef _OPENMP
+    omp_set_num_threads(savedThreads);
+#endif
+    return points;
+}
+
+// Таблица масштабирования в CSV (для графиков ускорения и эффективности)
+inline bool scalingWriteCsv(const std::string& path, const std::string& kernel,
+                            const std::vector<ScalingPoint>& points, bool append = false) {
+    std::ofstream out(path, append ? std::ios::app : std::ios::trunc);
+    if (!out) return false;
+    if (!append) out << "kernel,mode,threads,n,median_ns,speedup,efficiency,karp_flatt,ns_per_elem,gb_per_s\n";
+    for (const ScalingPoint& p : points) {
+        out << kernel << "," << p.mode << "," << p.threads << "," << p.n << "," << (long long)p.medianNs << ","
+            << p.speedup << "," << p.efficiency << "," << p.karpFlatt << "," << p.nsPerElem << ","
+            << p.gbPerSec << "\n";
+    }
+    return true;
+}
@@ -0,0 +1,187 @@
+#pragma once // Защита от многократного включения файла
+
+// Потоковая статистика по бинарному файлу (int32 или float64), который может быть больше RAM.
+// Файл не загружается целиком: он отображается в память (mmap) или читается большими
+// выровненными кусками, каждый кусок сворачивается параллельно (OpenMP reduction),
+// поэтому скорость упирается в диск / page cache, а не в выделение памяти.
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define STREAM_HAVE_POSIX 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Результат: сумма в long long для целых и в double для вещественных
+template <class T>
+struct StreamStats {
+    using Acc = typename std::conditional<std::is_integral<T>::value, long long, double>::type;
+    long long count = 0;
+    Acc sum = 0;
+    T mn = std::numeric_limits<T>::max();
+    T mx = std::numeric_limits<T>::lowest();
+    double seconds = 0;        // Общее время (чтение + вычисление)
+    double bytes = 0;
+
+    double mean() const { return count > 0 ? (double)sum / count : 0.0; }
+    double gbPerSec() const { return seconds > 0 ? bytes / seconds / 1e9 : 0.0; }
+};
+
+enum class StreamMode { Mmap, Read };
+
+// Свёртка одного куска в памяти: сумма, min и max за один проход
+template <class T>
+inline void streamReduceChunk(const T* p, long long n, StreamStats<T>& st) {
+    typename StreamStats<T>::Acc sum = 0;
+    T mn = st.mn, mx = st.mx;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+:sum) reduction(min:mn) reduction(max:mx) schedule(static)
+#endif
+    for (long long i = 0; i < n; i++) {
+        sum += p[i];
+        mn = std::min(mn, p[i]);
+        mx = std::max(mx, p[i]);
+    }
+    st.sum += sum;
+    st.mn = mn;
+    st.mx = mx;
+    st.count += n;
+}
+
+// Обработка файла кусками по chunkBytes. Возвращает false, если файл не открылся
+// или чтение завершилось ошибкой (причина печатается в stderr)
+template <class T>
+bool streamStatsFile(const std::string& path, StreamStats<T>& st,
+                     StreamMode mode = StreamMode::Mmap, size_t chunkBytes = (size_t)64 << 20) {
+    const size_t align = 4096;
+    chunkBytes = std::max(align, chunkBytes / align * align); // Кусок кратен странице и sizeof(T)
+    auto t0 = std::chrono::steady_clock::now();
+
+#ifdef STREAM_HAVE_POSIX
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat sb;
+    if (fstat(fd, &sb) != 0) { ::close(fd); return false; }
+    size_t fileBytes = (size_t)sb.st_size;
+    size_t usable = fileBytes / sizeof(T) * sizeof(T); // Хвост меньше одного элемента отбрасываем
+
+    if (mode == StreamMode::Mmap && usable > 0) {
+        void* map = mmap(nullptr, usable, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) { ::close(fd); return false; }
+        const char* base = (const char*)map;
+        madvise(map, usable, MADV_SEQUENTIAL); // Ядро читает вперёд агрессивнее
+        for (size_t off = 0; off < usable; off += chunkBytes) {
+            size_t len = std::min(chunkBytes, usable - off);
+            // Подсказка readahead: следующий кусок начнёт подгружаться, пока считаем текущий
+            if (off + len < usable)
+                madvise((void*)(base + off + len), std::min(chunkBytes, usable - off - len), MADV_WILLNEED);
+            streamReduceChunk((const T*)(base + off), (long long)(len / sizeof(T)), st);
+            // Обработанные страницы больше не нужны — не держим их в RSS
+            madvise((void*)(base + off), len, MADV_DONTNEED);
+        }
+        munmap(map, usable);
+    }
+    else if (usable > 0) {
+#ifdef POSIX_FADV_SEQUENTIAL
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+        void* buf = nullptr;
+        if (posix_memalign(&buf, align, chunkBytes) != 0) { ::close(fd); return false; }
+        size_t off = 0;
+        while (off < usable) {
+            size_t want = std::min(chunkBytes, usable - off);
+#ifdef POSIX_FADV_WILLNEED
+            if (off + want < usable)
+                posix_fadvise(fd, (off_t)(off + want), (off_t)std::min(chunkBytes, usable - off - want), POSIX_FADV_WILLNEED);
+#endif
+            size_t got = 0;
+            while (got < want) {
+                ssize_t r = ::pread(fd, (char*)buf + got, want - got, (off_t)(off + got));
+                if (r < 0 && errno == EINTR) continue;
+                if (r < 0) {
+                    std::fprintf(stderr, "stream: ошибка чтения %s: %s\n", path.c_str(), std::strerror(errno));
+                    std::free(buf);
+                    ::close(fd);
+                    return false;
+                }
+                if (r == 0) break; // Файл укоротился во время чтения
+                got += (size_t)r;
+            }
+            got = got / sizeof(T) * sizeof(T);
+            if (got == 0) break;
+            streamReduceChunk((const T*)buf, (long long)(got / sizeof(T)), st);
+            off += got;
+        }
+        std::free(buf);
+    }
+    ::close(fd);
+    st.bytes = (double)st.count * sizeof(T); // Реально обработано (файл мог укоротиться)
+#else
+    // Без POSIX (например, MSVC): обычное чтение кусками через stdio
+    (void)mode;
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return false;
+    T* buf = (T*)std::malloc(chunkBytes);
+    if (!buf) { std::fclose(f); return false; }
+    size_t got;
+    while ((got = std::fread(buf, sizeof(T), chunkBytes / sizeof(T), f)) > 0) {
+        streamReduceChunk((const T*)buf, (long long)got, st);
+        st.bytes += (double)got * sizeof(T);
+    }
+    const bool failed = std::ferror(f) != 0;
+    std::free(buf);
+    std::fclose(f);
+    if (failed) {
+        std::fprintf(stderr, "stream: ошибка чтения %s\n", path.c_str());
+        return false;
+    }
+#endif
+
+    auto t1 = std::chrono::steady_clock::now();
+    st.seconds = std::chrono::duration<double>(t1 - t0).count();
+    return true;
+}
+
+// Запись тестового файла из n элементов кусками (без выделения всего массива).
+// false — файл не записан целиком; частично записанный файл удаляется
+template <class T, class Gen>
+bool streamWriteTestFile(const std::string& path, long long n, Gen gen, size_t chunkElems = (size_t)1 << 22) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    T* buf = (T*)std::malloc(chunkElems * sizeof(T));
+    if (!buf) { std::fclose(f); return false; }
+    bool ok = true;
+    for (long long off = 0; off < n && ok; off += (long long)chunkElems) {
+        size_t len = (size_t)std::min<long long>((long long)chunkElems, n - off);
+        for (size_t i = 0; i < len; i++) buf[i] = gen(off + (long long)i);
+        ok = std::fwrite(buf, sizeof(T), len, f) == len; // Короче — например, кончилось место на диске
+    }
+    std::free(buf);
+    if (std::fclose(f) != 0) ok = false; // fclose сбрасывает буфер stdio и тоже может не записать хвост
+    if (!ok) {
+        std::fprintf(stderr, "stream: ошибка записи %s: %s\n", path.c_str(), std::strerror(errno));
+        // Усечённый файл дал бы статистику по меньшему числу элементов. Удаляем только обычный
+        // файл — путь может оказаться устройством или каналом
+#ifdef STREAM_HAVE_POSIX
+        struct stat sb;
+        if (::stat(path.c_str(), &sb) == 0 && S_ISREG(sb.st_mode))
+#endif
+            std::remove(path.c_str());
+    }
+    return ok;
+}
@@ -0,0 +1,459 @@
+#pragma once // Защита от многократного включения файла
+
+// Параллельный top-k и n-й элемент без полной сортировки.
+// Результат — пары (значение, индекс) в отсортированном порядке. Порядок полный: при равных значениях
+// раньше идёт меньший индекс, NaN — после всех чисел (и для наименьших, и для наибольших),
+// поэтому ответ не зависит от числа потоков.
+//   * topkSmallest / topkLargest — k наименьших / наибольших, k от 1 до n;
+//   * nthElement — элемент ранга k (0 — минимум) без сортировки остальных.
+// Два пути:
+//   * малые k (до kTopkHeapMaxK, см. useHeap): у каждого потока ограниченная max-куча из k лучших своего куска,
+//     один проход по массиву; почти все элементы отсекаются сравнением с вершиной кучи;
+//     кандидаты потоков (не больше k × потоков) сливаются nth_element + sort;
+//   * большие k (вплоть до n/2 при n = 10^8): параллельный выбор по выборке. По отсортированной
+//     выборке берутся две границы lo < hi вокруг ранга k; один проход считает элементы до lo и
+//     собирает полосу [lo, hi) (несколько процентов массива). Нужный ранг почти всегда попадает
+//     в полосу, его находит nth_element; если нет — полоса расширяется. Второй проход без ветвлений
+//     раскладывает ровно k элементов "не позже найденного" в порядке индексов по префиксным суммам,
+//     и их сортирует устойчивая параллельная LSD-радикс-сортировка по значению (равные значения так
+//     и остаются по индексу). Для прочих типов — куски std::sort + попарные слияния.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "counter_rng.h"
+#include "kernels.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+template <class T>
+struct RankedValue {
+    T value;
+    std::size_t index;  // Позиция во входном массиве
+};
+
+// До такого k используется путь с кучами (если кандидатов всех потоков не больше четверти массива),
+// дальше — выбор по выборке: куча дешевле, пока в неё попадает малая доля элементов
+constexpr std::size_t kTopkHeapMaxK = (std::size_t)1 << 17;
+
+namespace topk_detail {
+
+// Раскладка без ветвлений: элемент пишется в текущую ячейку всегда, курсор сдвигается только для
+// подходящих. Число подходящих в куске потока известно заранее, поэтому после последнего из них
+// запись уходит в sink и не задевает диапазон соседнего потока
+template <class RV>
+struct CompactWriter {
+    RV* p;
+    RV* end;
+    RV sink;
+
+    CompactWriter(RV* begin, RV* last) : p(begin), end(last), sink() {}
+    void put(const RV& x, bool take) {
+        *(p < end ? p : &sink) = x;
+        p += take;
+    }
+};
+
+template <class T> inline bool isNan(T) { return false; }
+inline bool isNan(float x) { return std::isnan(x); }
+inline bool isNan(double x) { return std::isnan(x); }
+
+// "a раньше b" в порядке ответа. Largest = false — по возрастанию, true — по убыванию.
+// NaN всегда в конце, равные значения — по возрастанию индекса
+template <class T, bool Largest>
+struct Before {
+    bool operator()(const RankedValue<T>& a, const RankedValue<T>& b) const {
+        const bool na = isNan(a.value), nb = isNan(b.value);
+        if (na || nb) return na == nb ? a.index < b.index : nb;
+        if (Largest ? b.value < a.value : a.value < b.value) return true;
+        if (Largest ? a.value < b.value : b.value < a.value) return false;
+        return a.index < b.index;
+    }
+};
+
+inline int maxThreads() {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+// Номер потока и размер команды внутри параллельной области. Команда бывает меньше num_threads
+// (OMP_THREAD_LIMIT, OMP_DYNAMIC, вызов из другой параллельной области), поэтому массив делится
+// на фиксированное число кусков, а потоки разбирают их по кругу: c = tid, tid + team, ...
+// Тогда каждый кусок обработан, и разбиение одинаково во всех областях одного вызова
+inline void teamInfo(int& tid, int& team) {
+    tid = 0;
+    team = 1;
+#ifdef _OPENMP
+    tid = omp_get_thread_num();
+    team = omp_get_num_threads();
+#endif
+}
+
+inline bool useHeap(std::size_t n, std::size_t k) {
+    return k <= kTopkHeapMaxK && k * (std::size_t)maxThreads() <= std::max<std::size_t>(n / 4, 1);
+}
+
+// Параллельная сортировка: nt кусков сортируются независимо, затем попарно сливаются через буфер
+template <class T, class Cmp>
+void parallelSort(std::vector<RankedValue<T>>& v, Cmp before) {
+    const std::size_t n = v.size();
+    const int nt = (int)std::min<std::size_t>((std::size_t)maxThreads(), std::max<std::size_t>(1, n / 4096));
+    std::vector<std::size_t> bound(nt + 1);
+    for (int t = 0; t <= nt; t++) bound[t] = n * (std::size_t)t / (std::size_t)nt;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) num_threads(nt)
+#endif
+    for (int t = 0; t < nt; t++) std::sort(v.begin() + bound[t], v.begin() + bound[t + 1], before);
+    if (nt == 1) return;
+
+    std::vector<RankedValue<T>> buf(n);
+    RankedValue<T>* src = v.data();
+    RankedValue<T>* dst = buf.data();
+    for (int width = 1; width < nt; width *= 2) {
+        const int pairs = (nt + 2 * width - 1) / (2 * width);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for (int p = 0; p < pairs; p++) {
+            const int l = p * 2 * width;
+            const std::size_t L = bound[l];
+            const std::size_t M = bound[std::min(l + width, nt)];
+            const std::size_t R = bound[std::min(l + 2 * width, nt)];
+            std::merge(src + L, src + M, src + M, src + R, dst + L, before);
+        }
+        std::swap(src, dst);
+    }
+    if (src != v.data()) std::copy(src, src + n, v.data());
+}
+
+// Путь с кучами: k лучших в порядке before
+template <class T, bool Largest>
+std::vector<RankedValue<T>> heapSelect(const T* a, std::size_t n, std::size_t k) {
+    typedef RankedValue<T> RV;
+    const Before<T, Largest> before;
+    const int nt = maxThreads();                        // Число кусков (см. teamInfo)
+    std::vector<std::vector<RV>> heaps(nt);
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nt)
+#endif
+    {
+        int tid, team;
+        teamInfo(tid, team);
+        for (int c = tid; c < nt; c += team) {
+            std::size_t L = 0, R = n;
+            kernels::staticChunk(n, c, nt, L, R);
+            std::vector<RV>& h = heaps[c];
+            h.reserve(k);
+            std::size_t i = L;
+            for (; i < R && h.size() < k; i++) {
+                h.push_back({a[i], i});
+                std::push_heap(h.begin(), h.end(), before); // На вершине — худший из k лучших
+            }
+            // Индексы растут, поэтому при равном значении новый элемент проигрывает вершине
+            for (; i < R; i++) {
+                const RV x{a[i], i};
+                if (!before(x, h.front())) continue;
+                std::pop_heap(h.begin(), h.end(), before);
+                h.back() = x;
+                std::push_heap(h.begin(), h.end(), before);
+            }
+        }
+    }
+    std::vector<RV> all;
+    for (const std::vector<RV>& h : heaps) all.insert(all.end(), h.begin(), h.end());
+    if (all.size() > k) {
+        std::nth_element(all.begin(), all.begin() + (k - 1), all.end(), before);
+        all.resize(k);
+    }
+    std::sort(all.begin(), all.end(), before);
+    return all;
+}
+
+// Ключ радикс-сортировки: беззнаковое число, порядок которого совпадает с Before (без учёта индекса).
+// Целые — инверсия знакового бита, вещественные — стандартный приём с битами IEEE, NaN — максимум
+template <class T, bool Largest>
+typename std::enable_if<std::is_integral<T>::value, std::uint64_t>::type radixKey(T x) {
+    std::uint64_t k = (std::uint64_t)(typename std::make_unsigned<T>::type)x;
+    if (std::is_signed<T>::value) k ^= (std::uint64_t)1 << (8 * sizeof(T) - 1);
+    const std::uint64_t mask = sizeof(T) == 8 ? ~(std::uint64_t)0 : (((std::uint64_t)1 << (8 * sizeof(T))) - 1);
+    return Largest ? ~k & mask : k;
+}
+
+template <class T, bool Largest>
+typename std::enable_if<std::is_floating_point<T>::value && sizeof(T) <= 8, std::uint64_t>::type radixKey(T x) {
+    typedef typename std::conditional<sizeof(T) == 4, std::uint32_t, std::uint64_t>::type Bits;
+    const Bits top = (Bits)1 << (8 * sizeof(T) - 1);
+    if (std::isnan(x)) return (Bits)~(Bits)0;              // NaN в конце при любом направлении
+    Bits b;
+    std::memcpy(&b, &x, sizeof(T));
+    if (b == top) b = 0;                                    // -0.0 == +0.0
+    b = (b & top) ? (Bits)~b : (Bits)(b | top);
+    return Largest ? (Bits)~b : b;                          // Ни одно число не получает ключ NaN
+}
+
+template <class T>
+struct HasRadixKey
+    : std::integral_constant<bool, (std::is_integral<T>::value || std::is_floating_point<T>::value) && sizeof(T) <= 8> {};
+
+// Граница полосы для проходов по массиву: "(v, i) раньше границы". Для типов с ключом радикс-сортировки —
+// сравнение целых ключей без ветвлений (на k ~ n/2 ветвление по значению ошибается в половине случаев)
+template <class T, bool Largest, bool Radix = HasRadixKey<T>::value>
+struct Bound {
+    std::uint64_t key;
+    std::size_t index;
+
+    explicit Bound(const RankedValue<T>& b) : key(radixKey<T, Largest>(b.value)), index(b.index) {}
+    bool before(T v, std::size_t i) const {
+        const std::uint64_t k = radixKey<T, Largest>(v);
+        return (k < key) | ((k == key) & (i < index));
+    }
+};
+
+template <class T, bool Largest>
+struct Bound<T, Largest, false> {
+    RankedValue<T> b;
+
+    explicit Bound(const RankedValue<T>& x) : b(x) {}
+    bool before(T v, std::size_t i) const { return Before<T, Largest>()(RankedValue<T>{v, i}, b); }
+};
+
+// Бит в цифре LSD-сортировки. Узкие цифры: 16 потоков записи помещаются в TLB и буферы записи;
+// на 5·10^7 пар 8 проходов по 4 бита оказались вдвое быстрее 4 проходов по 8 бит
+constexpr int kTopkRadixBits = 4;
+
+// Устойчивая параллельная LSD-сортировка по ключу значения.
+// Вход упорядочен по индексу, поэтому равные значения остаются по возрастанию индекса — ровно порядок Before
+template <class T, bool Largest>
+void radixSortByValue(std::vector<RankedValue<T>>& v) {
+    const std::size_t n = v.size();
+    const int nt = (int)std::min<std::size_t>((std::size_t)maxThreads(), std::max<std::size_t>(1, n / 65536));
+    std::vector<RankedValue<T>> buf(n);
+    RankedValue<T>* src = v.data();
+    RankedValue<T>* dst = buf.data();
+    constexpr int D = 1 << kTopkRadixBits;
+    constexpr std::uint64_t mask = D - 1;
+    std::vector<std::size_t> hist((std::size_t)nt * D);
+    for (int shift = 0; shift < 8 * (int)sizeof(T); shift += kTopkRadixBits) {
+        std::fill(hist.begin(), hist.end(), 0);
+        bool skip = false;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nt)
+#endif
+        {
+            int tid, team;
+            teamInfo(tid, team);
+            for (int c = tid; c < nt; c += team) {
+                std::size_t L = 0, R = n;
+                kernels::staticChunk(n, c, nt, L, R);
+                std::size_t* h = &hist[(std::size_t)c * D];
+                for (std::size_t i = L; i < R; i++) h[(radixKey<T, Largest>(src[i].value) >> shift) & mask]++;
+            }
+#ifdef _OPENMP
+#pragma omp barrier
+#pragma omp single
+#endif
+            {
+                // Смещения: сначала по цифре, внутри цифры — по номеру куска (устойчивость)
+                std::size_t sum = 0;
+                for (int d = 0; d < D; d++) {
+                    std::size_t digitTotal = 0;
+                    for (int t = 0; t < nt; t++) {
+                        const std::size_t c = hist[(std::size_t)t * D + d];
+                        hist[(std::size_t)t * D + d] = sum;
+                        sum += c;
+                        digitTotal += c;
+                    }
+                    if (digitTotal == n) skip = true;       // Все в одной корзине — проход ничего не меняет
+                }
+            }
+            if (!skip) {
+                for (int c = tid; c < nt; c += team) {
+                    std::size_t L = 0, R = n;
+                    kernels::staticChunk(n, c, nt, L, R);
+                    std::size_t off[D];                     // Локальная копия: не пересекается с dst
+                    std::copy(&hist[(std::size_t)c * D], &hist[(std::size_t)c * D] + D, off);
+                    for (std::size_t i = L; i < R; i++) dst[off[(radixKey<T, Largest>(src[i].value) >> shift) & mask]++] = src[i];
+                }
+            }
+        }
+        if (!skip) std::swap(src, dst);
+    }
+    if (src != v.data()) std::copy(src, src + n, v.data());
+}
+
+template <class T, bool Largest>
+void sortSelected(std::vector<RankedValue<T>>& v, std::true_type) { radixSortByValue<T, Largest>(v); }
+
+template <class T, bool Largest>
+void sortSelected(std::vector<RankedValue<T>>& v, std::false_type) { parallelSort(v, Before<T, Largest>()); }
+
+// Запасной последовательный выбор (тот же контракт, что у sampleSelect): nth_element по всем парам
+template <class T, bool Largest>
+RankedValue<T> serialSelect(const T* a, std::size_t n, std::size_t k, bool collect,
+                            std::vector<RankedValue<T>>& out) {
+    typedef RankedValue<T> RV;
+    const Before<T, Largest> before;
+    std::vector<RV> all(n);
+    for (std::size_t i = 0; i < n; i++) all[i] = RV{a[i], i};
+    std::nth_element(all.begin(), all.begin() + (k - 1), all.end(), before);
+    const RV pivot = all[k - 1];
+    if (collect) {
+        out.clear();
+        out.reserve(k);
+        for (std::size_t i = 0; i < n; i++)
+            if (!before(pivot, RV{a[i], i})) out.push_back(RV{a[i], i});
+    }
+    return pivot;
+}
+
+// Выбор по выборке: возвращает элемент ранга k-1 (k-й лучший). Если collect — в out все k лучших
+// по возрастанию индекса (готовый вход для устойчивой сортировки по значению)
+template <class T, bool Largest>
+RankedValue<T> sampleSelect(const T* a, std::size_t n, std::size_t k, bool collect,
+                            std::vector<RankedValue<T>>& out) {
+    typedef RankedValue<T> RV;
+    const Before<T, Largest> before;
+    const int nt = maxThreads();                        // Число кусков (см. teamInfo)
+
+    // Выборка ~ 2^16 элементов по псевдослучайным позициям (детерминированно)
+    const std::size_t S = std::min<std::size_t>(n, (std::size_t)1 << 16);
+    std::vector<RV> sample(S);
+    for (std::size_t s = 0; s < S; s++) {
+        const std::size_t i = S == n ? s : (std::size_t)(counterRandom(0x70b4, s) % n);
+        sample[s] = {a[i], i};
+    }
+    std::sort(sample.begin(), sample.end(), before);
+
+    // Ожидаемая позиция ранга k в выборке и запас в несколько стандартных отклонений
+    const double pos = (double)k * S / n;
+    double delta = 4.0 * std::sqrt((double)S) + 16.0;
+
+    std::vector<std::size_t> cntLess(nt);
+    std::vector<std::vector<RV>> bands(nt);   // Полоса каждого потока, по возрастанию индекса
+    RV pivot{};
+    for (int attempt = 0;; attempt++) {
+        // Границы полосы — элементы выборки; после трёх неудач полоса — весь массив
+        const long long loPos = (long long)std::floor(pos - delta);
+        const long long hiPos = (long long)std::ceil(pos + delta);
+        const bool hasLo = loPos >= 0 && attempt < 3;
+        const bool hasHi = hiPos < (long long)S && attempt < 3;
+        const Bound<T, Largest> lo(hasLo ? sample[(std::size_t)loPos] : sample[0]);
+        const Bound<T, Largest> hi(hasHi ? sample[(std::size_t)hiPos] : sample[0]);
+
+        // Один проход: счёт элементов строго до lo и сбор полосы [lo, hi) (несколько процентов массива)
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nt)
+#endif
+        {
+            int tid, team;
+            teamInfo(tid, team);
+            for (int c = tid; c < nt; c += team) {
+                std::size_t L = 0, R = n, less = 0;
+                kernels::staticChunk(n, c, nt, L, R);
+                std::vector<RV>& band = bands[c];
+                band.clear();
+                for (std::size_t i = L; i < R; i++) {
+                    const bool l = hasLo & lo.before(a[i], i);
+                    const bool h = !hasHi | hi.before(a[i], i);
+                    less += l;
+                    // Всё, что до lo, — и до hi, поэтому "в полосе" = h xor l: без перехода по l (~50 % на k ~ n/2)
+                    if (h ^ l) band.push_back(RV{a[i], i});
+                }
+                cntLess[c] = less;
+            }
+        }
+        std::size_t totalLess = 0, totalBand = 0;
+        for (int t = 0; t < nt; t++) {
+            totalLess += cntLess[t];
+            totalBand += bands[t].size();
+        }
+        if (k <= totalLess || k > totalLess + totalBand) {  // Ранг k вне полосы — расширяем
+            // Без границ полоса — весь массив, и k в неё попадает всегда. Если нет, какой-то кусок
+            // не обработан, и расширять дальше бесполезно — считаем последовательно
+            if (!hasLo && !hasHi) return serialSelect<T, Largest>(a, n, k, collect, out);
+            delta *= 4.0;
+            continue;
+        }
+
+        std::vector<RV> band;
+        band.reserve(totalBand);
+        for (const std::vector<RV>& b : bands) band.insert(band.end(), b.begin(), b.end());
+        const std::size_t need = k - totalLess;  // Сколько добрать из полосы, >= 1
+        std::nth_element(band.begin(), band.begin() + (need - 1), band.end(), before);
+        pivot = band[need - 1];
+        break;
+    }
+    if (!collect) return pivot;
+
+    // Ровно k элементов "не позже pivot" в порядке индексов. Сколько их у потока — его "до lo" плюс
+    // часть полосы; индексы целые, поэтому "не позже (v, i)" — то же, что "раньше (v, i + 1)"
+    const Bound<T, Largest> upTo(RV{pivot.value, pivot.index + 1});
+    std::vector<std::size_t> offset(nt + 1);
+    for (int t = 0; t < nt; t++) {
+        std::size_t c = cntLess[t];
+        for (const RV& x : bands[t]) c += upTo.before(x.value, x.index);
+        offset[t + 1] = offset[t] + c;
+    }
+    out.resize(k);
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nt)
+#endif
+    {
+        int tid, team;
+        teamInfo(tid, team);
+        for (int c = tid; c < nt; c += team) {
+            std::size_t L = 0, R = n;
+            kernels::staticChunk(n, c, nt, L, R);
+            CompactWriter<RV> w(out.data() + offset[c], out.data() + offset[c + 1]);
+            for (std::size_t i = L; i < R; i++) w.put(RV{a[i], i}, upTo.before(a[i], i));
+        }
+    }
+    return pivot;
+}
+
+template <class T, bool Largest>
+std::vector<RankedValue<T>> topk(const T* a, std::size_t n, std::size_t k) {
+    k = std::min(k, n);
+    if (k == 0) return {};
+    if (useHeap(n, k)) return heapSelect<T, Largest>(a, n, k);
+    std::vector<RankedValue<T>> out;
+    sampleSelect<T, Largest>(a, n, k, true, out);
+    sortSelected<T, Largest>(out, HasRadixKey<T>());
+    return out;
+}
+
+} // namespace topk_detail
+
+// k наименьших элементов a[0..n) по возрастанию (равные — по возрастанию индекса)
+template <class T>
+std::vector<RankedValue<T>> topkSmallest(const T* a, std::size_t n, std::size_t k) {
+    return topk_detail::topk<T, false>(a, n, k);
+}
+
+// k наибольших элементов a[0..n) по убыванию (равные — по возрастанию индекса)
+template <class T>
+std::vector<RankedValue<T>> topkLargest(const T* a, std::size_t n, std::size_t k) {
+    return topk_detail::topk<T, true>(a, n, k);
+}
+
+// Элемент ранга k (0 <= k < n) по возрастанию — то, что оказалось бы на месте k после сортировки.
+// k >= n ограничивается последним рангом (как k в topk); при n == 0 — {T(), 0}, индекс == n
+// означает "элемента нет". Массив не меняется; O(n) в среднем
+template <class T>
+RankedValue<T> nthElement(const T* a, std::size_t n, std::size_t k) {
+    if (n == 0) return RankedValue<T>{T(), 0};
+    k = std::min(k, n - 1);
+    std::vector<RankedValue<T>> unused;
+    if (topk_detail::useHeap(n, k + 1)) return topk_detail::heapSelect<T, false>(a, n, k + 1).back();
+    return topk_detail::sampleSelect<T, false>(a, n, k + 1, false, unused);
+}
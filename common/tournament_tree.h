@@ -0,0 +1,102 @@
+#pragma once // Защита от многократного включения файла
+
+// Турнирное дерево проигравших (loser tree) для задач вида
+// "много раз подряд взять минимум": построение O(n) параллельно, извлечение O(log n).
+// Заменяет n-1 параллельных поисков минимума в сортировке выбором.
+
+#include <cstddef>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+template <class T>
+class TournamentTree {
+public:
+    // Строит дерево над data[0..n); сами данные не копируются и не меняются
+    TournamentTree(const T* data, int n) : data_(data), n_(n), remaining_(n) {
+        leaves_ = 1;
+        while (leaves_ < n_) leaves_ <<= 1;
+        loser_.assign(leaves_, -1);
+        // win[v] — победитель (индекс минимума) поддерева v; листья лежат в [leaves_, 2*leaves_)
+        std::vector<int> win(2 * (std::size_t)leaves_);
+        int leaves = leaves_;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for (int i = 0; i < leaves; i++)
+                win[leaves + i] = (i < n) ? i : -1; // -1 — пустой лист (бесконечность)
+            // Уровни строятся снизу вверх; внутри уровня все матчи независимы
+            for (int first = leaves / 2; first >= 1; first /= 2) {
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+                for (int v = first; v < 2 * first; v++) {
+                    int l = win[2 * v];
+                    int r = win[2 * v + 1];
+                    bool leftWins = less(l, r);
+                    win[v] = leftWins ? l : r;
+                    loser_[v] = leftWins ? r : l; // В узле остаётся проигравший
+                }
+            }
+        }
+        loser_[0] = win[1]; // Общий победитель хранится в нулевом узле
+    }
+
+    bool empty() const { return remaining_ == 0; }
+    int size() const { return remaining_; }
+
+    // Индекс текущего минимума
+    int top() const { return loser_[0]; }
+
+    // Удаляет текущий минимум и возвращает его индекс.
+    // Переигрываются только матчи на пути от листа к корню — O(log n)
+    int pop() {
+        int w = loser_[0];
+        remaining_--;
+        int cur = -1; // Выбывший лист дальше играет как бесконечность
+        for (int v = (w + leaves_) >> 1; v >= 1; v >>= 1) {
+            if (less(loser_[v], cur)) {
+                int t = loser_[v];
+                loser_[v] = cur;
+                cur = t;
+            }
+        }
+        loser_[0] = cur;
+        return w;
+    }
+
+private:
+    // Сравнение участников: пустой или выбывший лист (-1) больше любого элемента,
+    // при равных значениях побеждает меньший индекс (извлечение устойчиво)
+    bool less(int i, int j) const {
+        if (i < 0) return false;
+        if (j < 0) return true;
+        if (data_[i] < data_[j]) return true;
+        if (data_[j] < data_[i]) return false;
+        return i < j;
+    }
+
+    const T* data_;
+    int n_;
+    int remaining_;
+    int leaves_;             // Число листьев (степень двойки)
+    std::vector<int> loser_; // loser_[v] — проигравший в узле v, loser_[0] — победитель
+};
+
+// Сортировка выбором через турнирное дерево: n извлечений минимума по O(log n)
+template <class T>
+void tournamentSelectionSort(std::vector<T>& a) {
+    int n = (int)a.size();
+    if (n <= 1) return;
+    std::vector<T> src = a;
+    TournamentTree<T> tree(src.data(), n);
+    for (int i = 0; i < n; i++)
+        a[i] = src[tree.pop()];
+}